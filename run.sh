@@ -1,12 +1,15 @@
 echo "Run benchmark for targets: $SPBENCH_TARGETS"
+echo "Extra benchmark options: $SPBENCH_OPTIONS"
+
+SPBENCH_CONFIG=${SPBENCH_CONFIG:-data/config.txt}
 
 # For each target we run as separate process for each matrix
 cat $SPBENCH_TARGETS | while read target; do
-  cat data/config.txt | while read test; do
+  cat $SPBENCH_CONFIG | while read test; do
     # Ignore lines, which start from comment mark
     if [[ ${test::1} != "%" ]]; then
-      echo "Exec command: ./$target -E $test"
-      ./$target -E $test
+      echo "Exec command: ./$target -E $test $SPBENCH_OPTIONS"
+      ./$target -E $test $SPBENCH_OPTIONS
     fi
   done
 done
\ No newline at end of file
@@ -0,0 +1,7 @@
+export SPBENCH_TARGETS="data/targets_bfs.txt"
+
+# Each iteration starts from its own pseudo-random source, the same for all backends
+for direction in push pull auto; do
+  export SPBENCH_OPTIONS="--direction=$direction"
+  bash run.sh
+done
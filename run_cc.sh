@@ -0,0 +1,11 @@
+# Labeling is verified across backends by components count and canonical labeling hash in Reference-Values.txt
+export SPBENCH_TARGETS="data/targets_cc.txt"
+export SPBENCH_OPTIONS=""
+bash run.sh
+
+export SPBENCH_TARGETS="data/targets_cc_native.txt"
+
+for algorithm in afforest lp; do
+  export SPBENCH_OPTIONS="--algorithm=$algorithm"
+  bash run.sh
+done
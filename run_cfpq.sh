@@ -0,0 +1,9 @@
+export SPBENCH_TARGETS="data/targets_cfpq.txt"
+
+# Index of large undirected graphs may be (almost) dense, so its growth is limited by the budget
+SPBENCH_NVALS_BUDGET=${SPBENCH_NVALS_BUDGET:-200000000}
+
+for grammar in data/grammars/*.txt; do
+  export SPBENCH_OPTIONS="--grammar=$grammar --max-nvals=$SPBENCH_NVALS_BUDGET"
+  bash run.sh
+done
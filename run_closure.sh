@@ -0,0 +1,9 @@
+export SPBENCH_TARGETS="data/targets_closure.txt"
+
+# Closure of large undirected graphs is (almost) dense, so growth of the result is limited by the budget
+SPBENCH_NVALS_BUDGET=${SPBENCH_NVALS_BUDGET:-200000000}
+
+for mode in squaring seminaive; do
+  export SPBENCH_OPTIONS="--mode=$mode --max-nvals=$SPBENCH_NVALS_BUDGET"
+  bash run.sh
+done
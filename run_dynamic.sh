@@ -0,0 +1,12 @@
+export SPBENCH_TARGETS="data/targets_dynamic.txt"
+
+# Stream of insertion batches, which is split off each dataset
+SPBENCH_BATCHES=${SPBENCH_BATCHES:-10}
+SPBENCH_SEED=${SPBENCH_SEED:-1}
+
+for batchSize in 100 10000; do
+  for mode in incremental full; do
+    export SPBENCH_OPTIONS="--mode=$mode --batches=$SPBENCH_BATCHES --batch-size=$batchSize --seed=$SPBENCH_SEED"
+    bash run.sh
+  done
+done
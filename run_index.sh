@@ -0,0 +1,6 @@
+export SPBENCH_TARGETS="data/targets_index.txt"
+
+for index in 32 64; do
+  export SPBENCH_OPTIONS="--index=$index"
+  bash run.sh
+done
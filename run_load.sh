@@ -0,0 +1,9 @@
+export SPBENCH_TARGETS="data/targets_load.txt"
+
+for format in mtx csr csrz; do
+  export SPBENCH_OPTIONS="--format=$format"
+  bash run.sh
+done
+
+export SPBENCH_OPTIONS="--format=mtx --loader=sharded"
+bash run.sh
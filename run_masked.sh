@@ -0,0 +1,16 @@
+export SPBENCH_TARGETS="data/targets_masked.txt"
+
+for mask in structure complement; do
+  export SPBENCH_OPTIONS="--mask=$mask"
+  bash run.sh
+done
+
+export SPBENCH_TARGETS="data/targets_masked_native.txt"
+export SPBENCH_OPTIONS="--mask=structure --kernel=dot"
+bash run.sh
+
+# Triangles are counted over undirected graphs only, count is verified across backends in Reference-Values.txt
+export SPBENCH_TARGETS="data/targets_tc.txt"
+export SPBENCH_CONFIG="data/config_undirected.txt"
+export SPBENCH_OPTIONS=""
+bash run.sh
@@ -0,0 +1,13 @@
+# Number of traversals per iteration, sources are the same for all backends
+SPBENCH_SOURCES=${SPBENCH_SOURCES:-1024}
+
+export SPBENCH_TARGETS="data/targets_msbfs.txt"
+export SPBENCH_OPTIONS="--sources=$SPBENCH_SOURCES"
+bash run.sh
+
+export SPBENCH_TARGETS="data/targets_msbfs_native.txt"
+
+for width in 64 256 512; do
+  export SPBENCH_OPTIONS="--sources=$SPBENCH_SOURCES --width=$width"
+  bash run.sh
+done
@@ -0,0 +1,3 @@
+export SPBENCH_TARGETS="data/targets_opencl.txt"
+export SPBENCH_OPTIONS="--profile-kernels"
+bash run.sh
\ No newline at end of file
@@ -0,0 +1,11 @@
+export SPBENCH_TARGETS="data/targets_panels.txt"
+
+# Memory budget of the product in MB (input, row sizes and markers, rest goes to the result panel)
+SPBENCH_BUDGET=${SPBENCH_BUDGET:-1024}
+
+for output in count hash file; do
+  export SPBENCH_OPTIONS="--budget-mb=$SPBENCH_BUDGET --output=$output"
+  bash run.sh
+done
+
+rm -f Product-Panels.csr
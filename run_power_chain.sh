@@ -0,0 +1,15 @@
+export SPBENCH_TARGETS="data/targets_power_chain.txt"
+
+# Powers of large graphs quickly become dense, so growth of the result is limited by the budget
+SPBENCH_POWER=${SPBENCH_POWER:-3}
+SPBENCH_NVALS_BUDGET=${SPBENCH_NVALS_BUDGET:-200000000}
+
+for mode in chain squaring; do
+  export SPBENCH_OPTIONS="--result=power --mode=$mode --power=$SPBENCH_POWER --max-nvals=$SPBENCH_NVALS_BUDGET"
+  bash run.sh
+done
+
+for mode in chain squaring frontier; do
+  export SPBENCH_OPTIONS="--result=sum --mode=$mode --power=$SPBENCH_POWER --max-nvals=$SPBENCH_NVALS_BUDGET"
+  bash run.sh
+done
@@ -0,0 +1,4 @@
+# SpGEMM cost predictors per matrix are stored in Metrics-Native-Profile.txt
+export SPBENCH_TARGETS="data/targets_profile.txt"
+export SPBENCH_OPTIONS="--block=1024"
+bash run.sh
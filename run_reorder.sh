@@ -0,0 +1,7 @@
+export SPBENCH_TARGETS=${SPBENCH_TARGETS:-data/targets_all.txt}
+
+# Reordering cost is stored as "reorder ms" metric next to mxm/add time of each ordering
+for ordering in none rcm degree hub community; do
+  export SPBENCH_OPTIONS="--reorder=$ordering"
+  bash run.sh
+done
@@ -0,0 +1,11 @@
+export SPBENCH_TARGETS="data/targets_rpq.txt"
+
+# Reachable set of large undirected graphs may be (almost) dense, so its growth is limited by the budget
+SPBENCH_NVALS_BUDGET=${SPBENCH_NVALS_BUDGET:-200000000}
+
+for automaton in data/automata/*.txt; do
+  for kronecker in streaming materialized; do
+    export SPBENCH_OPTIONS="--automaton=$automaton --kronecker=$kronecker --max-nvals=$SPBENCH_NVALS_BUDGET"
+    bash run.sh
+  done
+done
@@ -0,0 +1,15 @@
+# Density of the dense operand, the same random operand is generated for all backends
+SPBENCH_DENSITY=${SPBENCH_DENSITY:-0.05}
+
+for columns in 64 256 1024; do
+  export SPBENCH_TARGETS="data/targets_spmm.txt"
+
+  for format in bitmap full; do
+    export SPBENCH_OPTIONS="--columns=$columns --density=$SPBENCH_DENSITY --format=$format"
+    bash run.sh
+  done
+
+  export SPBENCH_TARGETS="data/targets_spmm_native.txt"
+  export SPBENCH_OPTIONS="--columns=$columns --density=$SPBENCH_DENSITY"
+  bash run.sh
+done
@@ -0,0 +1,7 @@
+export SPBENCH_TARGETS="data/targets_symbolic.txt"
+
+# Difference between modes is the cost of the output materialization
+for output in full symbolic hash; do
+  export SPBENCH_OPTIONS="--output=$output"
+  bash run.sh
+done
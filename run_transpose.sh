@@ -0,0 +1,16 @@
+export SPBENCH_TARGETS="data/targets_transpose.txt"
+
+# Transpose is done once per matrix (outside of measured time) or on each iteration (inside of measured time)
+for op in AAt AtA; do
+  for transpose in cached inline; do
+    export SPBENCH_OPTIONS="--op=$op --transpose=$transpose"
+    bash run.sh
+  done
+done
+
+# Transpose is fused into mxm by SuiteSparse descriptors
+for op in AAt AtA; do
+  export SPBENCH_TARGETS="data/targets_transpose_descriptor.txt"
+  export SPBENCH_OPTIONS="--op=$op --transpose=descriptor"
+  bash run.sh
+done
@@ -31,6 +31,9 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <map>
+#include <stdexcept>
+#include <matrix_generator.hpp>
 
 namespace benchmark {
 
@@ -42,6 +45,11 @@ namespace benchmark {
             std::string name;
             bool isUndirected;
             size_t iterations;
+
+            /** @return True if entry is a synthetic generator spec `gen:<kind>:...` instead of a file */
+            bool isGenerated() const {
+                return MatrixGenerator::isSpec(name);
+            }
         };
 
         void parse(int argc, const char** argv) {
@@ -60,7 +68,7 @@ namespace benchmark {
             mArgv = argv;
 
             if (std::string(argv[1]) == "-E") {
-                assert(argc == 5);
+                assert(argc >= 5);
 
                 std::string name = argv[2];
                 int isUndirected = 0;
@@ -73,7 +81,10 @@ namespace benchmark {
                 lineParser >> iterations;
 
                 Entry entry{ std::move(name), isUndirected != 0, iterations };
-                mEntries.push_back(std::move(entry));
+                if (!addEntry(std::move(entry)))
+                    return;
+
+                parseOptions(5);
             } else {
                 // Suppose, the second one is the name of the file with the config of input data
                 const char* configName = argv[1];
@@ -100,13 +111,27 @@ namespace benchmark {
                     lineParser >> name >> isUndirected >> iterations;
 
                     Entry entry{ std::move(name), isUndirected != 0, iterations };
-                    mEntries.push_back(std::move(entry));
+                    if (!addEntry(std::move(entry)))
+                        return;
                 }
+
+                parseOptions(2);
             }
 
             mIsParsed = true;
         }
 
+        /** @return True if option `--name` or `--name=value` was passed after the input data args */
+        bool hasOption(const std::string& name) const {
+            return mOptions.find(name) != mOptions.end();
+        }
+
+        /** @return Value of the option `--name=value` or default value if the option was not passed */
+        std::string getOption(const std::string& name, const std::string& defaultValue = "") const {
+            auto found = mOptions.find(name);
+            return found != mOptions.end()? found->second: defaultValue;
+        }
+
         bool isParsed() const {
             return mIsParsed;
         }
@@ -123,11 +148,47 @@ namespace benchmark {
             return mAsString;
         }
 
+    private:
+
+        bool addEntry(Entry entry) {
+            // Malformed generator specs are reported before any benchmark setup
+            if (entry.isGenerated()) {
+                try {
+                    MatrixGenerator::validate(entry.name);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << e.what() << std::endl;
+                    return false;
+                }
+            }
+
+            mEntries.push_back(std::move(entry));
+            return true;
+        }
+
+        void parseOptions(int first) {
+            for (int i = first; i < mArgc; i++) {
+                std::string arg = mArgv[i];
+
+                if (arg.size() < 3 || arg[0] != '-' || arg[1] != '-') {
+                    std::cerr << "Ignore unknown argument: " << arg << std::endl;
+                    continue;
+                }
+
+                auto separator = arg.find('=');
+                auto name = arg.substr(2, separator == std::string::npos? std::string::npos: separator - 2);
+                auto value = separator == std::string::npos? std::string(): arg.substr(separator + 1);
+
+                mOptions[name] = std::move(value);
+            }
+        }
+
     private:
         int mArgc = 0;
         const char** mArgv = nullptr;
         bool mIsParsed = false;
         std::vector<Entry> mEntries;
+        std::map<std::string, std::string> mOptions;
         std::string mAsString;
     };
 
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_AUTOMATON_HPP
+#define SPBENCH_AUTOMATON_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <exception>
+#include <algorithm>
+#include <cassert>
+
+namespace benchmark {
+
+    /**
+     * Finite automaton of the regular path query (without epsilon transitions).
+     *
+     * Text format: `%` starts a comment line, states are numbered from 0.
+     *   start q        start state
+     *   final q1 q2    final states
+     *   q1 label q2    transition from q1 to q2 by edge label
+     */
+    class Automaton {
+    public:
+
+        struct Transition {
+            size_t from;
+            std::string label;
+            size_t to;
+        };
+
+        Automaton() = default;
+
+        explicit Automaton(std::string path) : path(std::move(path)) {
+
+        }
+
+        /** Attempts to load automaton */
+        void loadData() {
+            assert(!loaded);
+
+            std::ifstream file;
+            file.open(path, std::ios_base::in);
+
+            if (!file.is_open()) {
+                error = "Failed to open file " + path;
+                throw std::runtime_error(error);
+            }
+
+            std::string line;
+            bool hasStart = false;
+
+            while (std::getline(file, line)) {
+                if (line.empty() || line[0] == '%')
+                    continue;
+
+                std::stringstream lineStream(line);
+                std::string token;
+                lineStream >> token;
+
+                if (token == "start") {
+                    lineStream >> start;
+                    statesCount = std::max(statesCount, start + 1);
+                    hasStart = true;
+                }
+                else if (token == "final") {
+                    size_t state;
+                    while (lineStream >> state) {
+                        finals.push_back(state);
+                        statesCount = std::max(statesCount, state + 1);
+                    }
+                }
+                else {
+                    Transition transition;
+                    transition.from = std::stoull(token);
+                    lineStream >> transition.label >> transition.to;
+
+                    if (lineStream.fail()) {
+                        error = "Invalid transition: " + line;
+                        throw std::runtime_error(error);
+                    }
+
+                    statesCount = std::max(statesCount, std::max(transition.from, transition.to) + 1);
+                    transitions.push_back(std::move(transition));
+                }
+            }
+
+            if (!hasStart || finals.empty()) {
+                error = "Automaton must have start and final states " + path;
+                throw std::runtime_error(error);
+            }
+
+            loaded = true;
+        }
+
+        bool isLoaded() const {
+            return loaded;
+        }
+
+        size_t getStatesCount() const {
+            return statesCount;
+        }
+
+        size_t getStart() const {
+            return start;
+        }
+
+        const std::vector<size_t>& getFinals() const {
+            return finals;
+        }
+
+        const std::vector<Transition>& getTransitions() const {
+            return transitions;
+        }
+
+    private:
+        bool loaded = false;
+        std::string path;
+        std::string error;
+        size_t statesCount = 0;
+        size_t start = 0;
+        std::vector<size_t> finals;
+        std::vector<Transition> transitions;
+    };
+
+}
+
+#endif //SPBENCH_AUTOMATON_HPP
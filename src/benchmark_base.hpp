@@ -34,6 +34,8 @@
 #include <fstream>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
 
 namespace benchmark {
 
@@ -108,10 +110,49 @@ namespace benchmark {
             double maxIterationTime = 0.0;
             double standardDeviationMs = 0.0f;
             std::vector<double> samplesMs;
+            std::vector<std::pair<std::string, TimeQuery>> stages;
+            // Values of metrics are accumulated and averaged by TimeQuery as well
+            std::vector<std::pair<std::string, TimeQuery>> metrics;
         };
 
         std::vector<PerExperiment> results;
 
+        /**
+         * Report time of the named part of the current iteration (for instance, device time of some kernel).
+         * Samples with the same name are summed within iteration and averaged over the iterations of experiment.
+         *
+         * @param stage Name of the stage
+         * @param ms Time in milliseconds
+         */
+        void addStageSample(const std::string& stage, double ms) {
+            for (auto& s: iterationStages) {
+                if (s.first == stage) {
+                    s.second += ms;
+                    return;
+                }
+            }
+
+            iterationStages.emplace_back(stage, ms);
+        }
+
+        /**
+         * Report named value of the current iteration (for instance, throughput in GB/s).
+         * Last sample with the same name within iteration is taken, samples are averaged over the iterations of experiment.
+         *
+         * @param metric Name of the metric (with units)
+         * @param value Value of the metric
+         */
+        void addMetric(const std::string& metric, double value) {
+            for (auto& m: iterationMetrics) {
+                if (m.first == metric) {
+                    m.second = value;
+                    return;
+                }
+            }
+
+            iterationMetrics.emplace_back(metric, value);
+        }
+
         //////////////////////////////////////////////////
         // Override functions below for your benchmark
 
@@ -132,6 +173,29 @@ namespace benchmark {
 
         std::fstream log;
 
+    private:
+
+        std::vector<std::pair<std::string, double>> iterationStages;
+        std::vector<std::pair<std::string, double>> iterationMetrics;
+
+        static void mergeSamples(std::vector<std::pair<std::string, double>>& samples,
+                                 std::vector<std::pair<std::string, TimeQuery>>& queries) {
+            for (auto& sample: samples) {
+                auto found = std::find_if(queries.begin(), queries.end(), [&](const std::pair<std::string, TimeQuery>& q) {
+                    return q.first == sample.first;
+                });
+
+                if (found == queries.end())
+                    found = queries.insert(found, { sample.first, TimeQuery{} });
+
+                found->second.addTimeSample(sample.second);
+            }
+
+            samples.clear();
+        }
+
+    public:
+
         void runBenchmark() {
             assert(experimentsCount > 0);
             assert(results.empty());
@@ -177,6 +241,9 @@ namespace benchmark {
 
                     tearDownIteration(experimentIdx, iterationIdx);
 
+                    mergeSamples(iterationStages, perExperiment.stages);
+                    mergeSamples(iterationMetrics, perExperiment.metrics);
+
                     double elapsedTimeMs = timer.getElapsedTimeMs();
 
                     timeQuery.addTimeSample(elapsedTimeMs);
@@ -225,6 +292,21 @@ namespace benchmark {
                     id += 1;
                 }
 
+                if (!perExperiment.stages.empty()) {
+                    log << ">  stages (average per iteration): " << std::endl;
+                    for (auto& stage: perExperiment.stages) {
+                        log << ">   " << stage.first << ": " << stage.second.getAverageTimeMs() << " ms ("
+                            << 100.0 * stage.second.getAverageTimeMs() / perExperiment.averageTime << "% of wall)" << std::endl;
+                    }
+                }
+
+                if (!perExperiment.metrics.empty()) {
+                    log << ">  metrics (average per iteration): " << std::endl;
+                    for (auto& metric: perExperiment.metrics) {
+                        log << ">   " << metric.first << ": " << metric.second.getAverageTimeMs() << std::endl;
+                    }
+                }
+
                 log << std::endl;
                 results.push_back(std::move(perExperiment));
             }
@@ -269,6 +351,45 @@ namespace benchmark {
                 }
             }
 
+            // Stages breakdown goes next to the wall time, if benchmark reports any
+            if (std::any_of(results.begin(), results.end(), [](const PerExperiment& r) { return !r.stages.empty(); })) {
+                std::string stagesName = "Stages-" + benchmarkName + ".txt";
+                std::fstream stagesFile;
+
+                stagesFile.open(stagesName, std::ios_base::out | std::ios_base::app);
+
+                if (stagesFile.is_open()) {
+                    for (auto& r: results) {
+                        stagesFile << r.userFriendlyName << ": wall " << r.averageTime << " ms" << std::endl;
+
+                        for (auto& stage: r.stages) {
+                            stagesFile << std::setw(50) << stage.first << ": "
+                                       << std::setw(15) << stage.second.getAverageTimeMs() << " ms "
+                                       << std::setw(15) << 100.0 * stage.second.getAverageTimeMs() / r.averageTime << " %" << std::endl;
+                        }
+                    }
+                }
+            }
+
+            // Metrics go in the same way
+            if (std::any_of(results.begin(), results.end(), [](const PerExperiment& r) { return !r.metrics.empty(); })) {
+                std::string metricsName = "Metrics-" + benchmarkName + ".txt";
+                std::fstream metricsFile;
+
+                metricsFile.open(metricsName, std::ios_base::out | std::ios_base::app);
+
+                if (metricsFile.is_open()) {
+                    for (auto& r: results) {
+                        metricsFile << r.userFriendlyName << ": wall " << r.averageTime << " ms" << std::endl;
+
+                        for (auto& metric: r.metrics) {
+                            metricsFile << std::setw(50) << metric.first << ": "
+                                        << std::setw(15) << metric.second.getAverageTimeMs() << std::endl;
+                        }
+                    }
+                }
+            }
+
             log << "=-=-=-=-=-= FINISH: " << benchmarkName << " =-=-=-=-=-=" << std::endl;
         }
     };
@@ -25,12 +25,16 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 // clBool goes here
 #include <library_classes/controls.hpp>
 #include <library_classes/cpu_matrices.hpp>
 #include <coo/coo_utils.hpp>
 #include <common/utils.hpp>
+#include <common/matrices_conversions.hpp>
 #include <dcsr/dcsr_matrix_multiplication_hash.hpp>
 #include <coo/coo_matrix_addition.hpp>
 
@@ -45,13 +49,22 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "Clbool-Add";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
+
+            uploadMode = argsProcessor.getOption("upload", "copy");
+            assert(uploadMode == "copy" || uploadMode == "mapped");
         }
 
     protected:
 
         void setupBenchmark() override {
-            controls = new Controls(utils::create_controls());
+            controls = new Controls(utils::create_controls(argsProcessor.hasOption("profile-kernels")));
         }
 
         void tearDownBenchmark() override {
@@ -71,6 +84,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load A: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -80,13 +98,31 @@ namespace benchmark {
                 size_t n = input.nrows;
                 assert(input.nrows == input.ncols);
 
-                A = std::move(matrix_coo(*controls, n, n, input.nvals, input.rows, input.cols, true));
+                Timer timer;
+                timer.start();
+
+                if (uploadMode == "mapped") {
+                    A = std::move(matrix_coo_from_sorted_coo_mapped(*controls, input.rows, input.cols, n, n));
+                }
+                else {
+                    A = std::move(matrix_coo(*controls, n, n, input.nvals, input.rows, input.cols, true));
+                }
+
+                timer.end();
+
+#ifdef BENCH_DEBUG
+                log   << ">   Upload A (" << uploadMode << "): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
             }
 
             MatrixLoader2 loader2(file);
             loader2.loadData();
             input = std::move(loader2.getMatrix());
 
+            // The same permutation keeps A^2 consistent with relabeled A
+            if (reorder.isEnabled())
+                reorder.permute(input);
+
 #ifdef BENCH_DEBUG
             log       << ">   Load A2: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -96,7 +132,21 @@ namespace benchmark {
                 size_t n = input.nrows;
                 assert(input.nrows == input.ncols);
 
-                A2 = std::move(matrix_coo(*controls, n, n, input.nvals, input.rows, input.cols, true));
+                Timer timer;
+                timer.start();
+
+                if (uploadMode == "mapped") {
+                    A2 = std::move(matrix_coo_from_sorted_coo_mapped(*controls, input.rows, input.cols, n, n));
+                }
+                else {
+                    A2 = std::move(matrix_coo(*controls, n, n, input.nvals, input.rows, input.cols, true));
+                }
+
+                timer.end();
+
+#ifdef BENCH_DEBUG
+                log   << ">   Upload A2 (" << uploadMode << "): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
             }
         }
 
@@ -107,7 +157,7 @@ namespace benchmark {
         }
 
         void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
-
+            controls->profiler.clear();
         }
 
         void execIteration(size_t experimentIdx, size_t iterationIdx) override {
@@ -115,9 +165,28 @@ namespace benchmark {
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (controls->profiling) {
+                for (const auto& record: controls->profiler.collect()) {
+                    addStageSample(record.tag(), record.time_ms);
+                }
+            }
+
+            // Fingerprint is computed on the host copy, outside of measured region
+            Fingerprint fingerprint;
+            if (R.nnz() > 0) {
+                auto r = matrix_coo_from_gpu(*controls, R);
+                fingerprint = fingerprintCoo(r.rows_indices().size(), r.rows_indices().data(), r.cols_indices().data());
+            }
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":A+AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << R.nRows() << " x " << R.nCols()
-                << " nvals " << R.nnz() << std::endl;
+                << " nvals " << R.nnz() << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             R = matrix_coo{};
@@ -130,7 +199,10 @@ namespace benchmark {
         matrix_coo A2;
         matrix_coo R;
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
+        std::string uploadMode;
         Matrix input;
     };
 
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
+
+// clBool goes here
+#include <library_classes/cpu_matrices.hpp>
+#include <coo/coo_utils.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Multiply: public BenchmarkBase {
+    public:
+
+        Multiply(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            auto backendName = argsProcessor.getOption("backend", "parallel");
+            backend = coo_utils::cpu_backend_from_name(backendName);
+
+            benchmarkName = "Clbool-Cpu-Multiply-" + backendName;
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t &iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
+#ifdef BENCH_DEBUG
+            log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                      << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            matrix_coo_cpu_pairs matrixA;
+            matrixA.reserve(input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                matrixA.push_back({ input.rows[i], input.cols[i] });
+            }
+
+            A = coo_utils::coo_to_dcsr_cpu(backend, matrixA);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = matrix_dcsr_cpu{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            coo_utils::matrix_multiplication_cpu(backend, R, A, A);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            auto fingerprint = fingerprintDcsr(R.rows_compressed().size(), R.rows_compressed().data(),
+                                               R.rows_pointers().data(), R.cols_indices().data());
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols
+                << " nvals " << R.cols_indices().size() << " fingerprint " << fingerprint.toString() << std::endl;
+#endif
+
+            R = matrix_dcsr_cpu{};
+        }
+
+    protected:
+
+        coo_utils::cpu_backend backend;
+        matrix_dcsr_cpu A;
+        matrix_dcsr_cpu R;
+
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Multiply multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
\ No newline at end of file
@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 // clBool goes here
 #include <library_classes/controls.hpp>
@@ -45,13 +48,22 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "Clbool-Multiply";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
+
+            uploadMode = argsProcessor.getOption("upload", "copy");
+            assert(uploadMode == "copy" || uploadMode == "mapped");
         }
 
     protected:
 
         void setupBenchmark() override {
-            controls = new Controls(utils::create_controls());
+            controls = new Controls(utils::create_controls(argsProcessor.hasOption("profile-kernels")));
         }
 
         void tearDownBenchmark() override {
@@ -71,6 +83,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -79,16 +96,31 @@ namespace benchmark {
             size_t n = input.nrows;
             assert(input.nrows == input.ncols);
 
-            matrix_coo_cpu_pairs matrixA;
-            matrixA.reserve(input.nvals);
+            Timer timer;
+            timer.start();
 
-            for (auto i = 0; i < input.nvals; i++) {
-                matrixA.push_back({ input.rows[i], input.cols[i] });
+            if (uploadMode == "mapped") {
+                // Input is sorted by loader, so dcsr is built right inside device buffers
+                A = std::move(matrix_dcsr_from_sorted_coo_mapped(*controls, input.rows, input.cols, n, n));
             }
+            else {
+                matrix_coo_cpu_pairs matrixA;
+                matrixA.reserve(input.nvals);
 
-            matrix_dcsr_cpu matrixDcsrA = coo_utils::coo_to_dcsr_cpu(matrixA);
+                for (auto i = 0; i < input.nvals; i++) {
+                    matrixA.push_back({ input.rows[i], input.cols[i] });
+                }
 
-            A = std::move(matrix_dcsr_from_cpu(*controls, matrixDcsrA, n));
+                matrix_dcsr_cpu matrixDcsrA = coo_utils::coo_to_dcsr_cpu_parallel(matrixA);
+
+                A = std::move(matrix_dcsr_from_cpu(*controls, matrixDcsrA, n));
+            }
+
+            timer.end();
+
+#ifdef BENCH_DEBUG
+            log       << ">   Upload matrix (" << uploadMode << "): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
         }
 
         void tearDownExperiment(size_t experimentIdx) override {
@@ -97,7 +129,7 @@ namespace benchmark {
         }
 
         void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
-
+            controls->profiler.clear();
         }
 
         void execIteration(size_t experimentIdx, size_t iterationIdx) override {
@@ -105,9 +137,29 @@ namespace benchmark {
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (controls->profiling) {
+                for (const auto& record: controls->profiler.collect()) {
+                    addStageSample(record.tag(), record.time_ms);
+                }
+            }
+
+            // Fingerprint is computed on the host copy, outside of measured region
+            Fingerprint fingerprint;
+            if (R.nnz() > 0) {
+                auto r = matrix_dcsr_from_gpu(*controls, R);
+                fingerprint = fingerprintDcsr(r.rows_compressed().size(), r.rows_compressed().data(),
+                                              r.rows_pointers().data(), r.cols_indices().data());
+            }
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << R.nRows() << " x " << R.nCols()
-                << " nvals " << R.nnz() << std::endl;
+                << " nvals " << R.nnz() << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             R = matrix_dcsr{};
@@ -119,7 +171,10 @@ namespace benchmark {
         matrix_dcsr A;
         matrix_dcsr R;
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
+        std::string uploadMode;
         Matrix input;
     };
 
@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 #include <clSPARSE.h>
 #include <clSPARSE-error.h>
@@ -42,7 +45,16 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "clSPARSE-Multiply";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
+
+            uploadMode = argsProcessor.getOption("upload", "copy");
+            assert(uploadMode == "copy" || uploadMode == "mapped");
         }
 
     protected:
@@ -140,6 +152,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -151,34 +168,110 @@ namespace benchmark {
             Status = clsparseInitCsrMatrix(&M);
             assert(Status == clsparseStatus::clsparseSuccess);
 
-            std::vector<clsparseIdx_t> rowsPtr(n + 1, 0);
-            std::vector<clsparseIdx_t> colsInd(input.nvals);
-            std::vector<float> values(input.nvals, 1.0f);
+            M.num_rows = n;
+            M.num_cols = n;
+            M.num_nonzeros = input.nvals;
+
+            Timer timer;
+            timer.start();
+
+            if (uploadMode == "mapped") {
+                // Csr is built right inside device buffers, no intermediate host vectors
+                M.row_pointer = createMappedBuffer<clsparseIdx_t>(n + 1, [&](clsparseIdx_t* rowsPtr) {
+                    std::fill(rowsPtr, rowsPtr + n + 1, 0);
 
-            for (auto i = 0; i < input.nvals; i++) {
-                rowsPtr[input.rows[i]] += 1;
-                colsInd[i] = input.cols[i];
+                    for (auto i = 0; i < input.nvals; i++) {
+                        rowsPtr[input.rows[i]] += 1;
+                    }
+
+                    clsparseIdx_t sum = 0;
+                    for (size_t r = 0; r < n + 1; r++) {
+                        clsparseIdx_t prev = sum;
+                        sum += rowsPtr[r];
+                        rowsPtr[r] = prev;
+                    }
+                });
+                assert(M.row_pointer != nullptr);
+
+                M.col_indices = createMappedBuffer<clsparseIdx_t>(input.nvals, [&](clsparseIdx_t* colsInd) {
+                    std::copy(input.cols.begin(), input.cols.end(), colsInd);
+                });
+                assert(M.col_indices != nullptr);
+
+                M.values = createMappedBuffer<float>(input.nvals, [&](float* values) {
+                    std::fill(values, values + input.nvals, 1.0f);
+                });
+                assert(M.values != nullptr);
             }
+            else {
+                std::vector<clsparseIdx_t> rowsPtr(n + 1, 0);
+                std::vector<clsparseIdx_t> colsInd(input.nvals);
+                std::vector<float> values(input.nvals, 1.0f);
+
+                for (auto i = 0; i < input.nvals; i++) {
+                    rowsPtr[input.rows[i]] += 1;
+                    colsInd[i] = input.cols[i];
+                }
 
-            clsparseIdx_t sum = 0;
-            for (auto& r: rowsPtr) {
-                clsparseIdx_t prev = sum;
-                sum += r;
-                r = prev;
+                clsparseIdx_t sum = 0;
+                for (auto& r: rowsPtr) {
+                    clsparseIdx_t prev = sum;
+                    sum += r;
+                    r = prev;
+                }
+
+                M.row_pointer = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(clsparseIdx_t) * (rowsPtr.size()), rowsPtr.data(),&clStatus);
+                assert(M.row_pointer != nullptr);
+
+                M.col_indices = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(clsparseIdx_t) * (colsInd.size()), colsInd.data() ,&clStatus);
+                assert(M.col_indices != nullptr);
+
+                M.values = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(float) * (values.size()), values.data() ,&clStatus);
+                assert(M.values != nullptr);
             }
 
-            M.num_rows = n;
-            M.num_cols = n;
-            M.num_nonzeros = input.nvals;
+            timer.end();
+
+#ifdef BENCH_DEBUG
+            log       << ">   Upload matrix (" << uploadMode << "): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
+        }
+
+        /**
+         * Creates CL_MEM_ALLOC_HOST_PTR buffer and fills it in place through the mapped pointer.
+         * On CPU devices and iGPUs this memory is used by device directly, so no host-device copy is made.
+         */
+        template<typename T, typename Fill>
+        cl_mem createMappedBuffer(size_t count, Fill fill) {
+            cl_mem buffer = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_ALLOC_HOST_PTR, sizeof(T) * count, nullptr, &clStatus);
+            if (clStatus != CL_SUCCESS)
+                return nullptr;
+
+            // Host writes to READ_ONLY (for kernels) buffer are allowed through mapping
+            auto ptr = (T*) ::clEnqueueMapBuffer(clCommandQueue(), buffer, CL_TRUE, CL_MAP_WRITE, 0, sizeof(T) * count, 0, nullptr, nullptr, &clStatus);
+            assert(clStatus == CL_SUCCESS);
+
+            fill(ptr);
 
-            M.row_pointer = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(clsparseIdx_t) * (rowsPtr.size()), rowsPtr.data(),&clStatus);
-            assert(M.row_pointer != nullptr);
+            clStatus = ::clEnqueueUnmapMemObject(clCommandQueue(), buffer, ptr, 0, nullptr, nullptr);
+            assert(clStatus == CL_SUCCESS);
 
-            M.col_indices = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(clsparseIdx_t) * (colsInd.size()), colsInd.data() ,&clStatus);
-            assert(M.col_indices != nullptr);
+            clStatus = ::clFinish(clCommandQueue());
+            assert(clStatus == CL_SUCCESS);
 
-            M.values = ::clCreateBuffer(clContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(float) * (values.size()), values.data() ,&clStatus);
-            assert(M.values != nullptr);
+            return buffer;
+        }
+
+        template<typename T>
+        std::vector<T> readBuffer(cl_mem buffer, size_t count) {
+            std::vector<T> data(count);
+
+            if (count > 0) {
+                clStatus = ::clEnqueueReadBuffer(clCommandQueue(), buffer, CL_TRUE, 0, sizeof(T) * count, data.data(), 0, nullptr, nullptr);
+                assert(clStatus == CL_SUCCESS);
+            }
+
+            return data;
         }
 
         void tearDownExperiment(size_t experimentIdx) override {
@@ -199,9 +292,20 @@ namespace benchmark {
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Fingerprint is computed on the host copy, outside of measured region
+            auto rowsPtr = readBuffer<clsparseIdx_t>(R.row_pointer, R.num_rows + 1);
+            auto colsInd = readBuffer<clsparseIdx_t>(R.col_indices, R.num_nonzeros);
+            auto fingerprint = fingerprintCsr(R.num_rows, rowsPtr.data(), colsInd.data());
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << R.num_rows << " x " << R.num_cols
-                << " nvals " << R.num_nonzeros << std::endl;
+                << " nvals " << R.num_nonzeros << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             clReleaseMemObject(R.values);
@@ -224,7 +328,10 @@ namespace benchmark {
         cl_int clStatus;
 
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
+        std::string uploadMode;
         Matrix input;
     };
 
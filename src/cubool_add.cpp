@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 #include <cubool/cubool.h>
 
@@ -41,6 +44,12 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "Cubool-Add";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -67,6 +76,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -82,6 +96,10 @@ namespace benchmark {
             loader2.loadData();
             input = std::move(loader2.getMatrix());
 
+            // The same permutation keeps A^2 consistent with relabeled A
+            if (reorder.isEnabled())
+                reorder.permute(input);
+
             CUBOOL_CHECK(cuBool_Matrix_New(&A2, n, n));
             CUBOOL_CHECK(cuBool_Matrix_Build(A2, input.rows.data(), input.cols.data(), input.nvals, CUBOOL_HINT_NO));
         }
@@ -117,8 +135,21 @@ namespace benchmark {
                 CUBOOL_CHECK(cuBool_Matrix_Ncols(R, &ncols));
                 CUBOOL_CHECK(cuBool_Matrix_Nvals(R, &nvals));
 
+                // Fingerprint is computed on the host copy, outside of measured region
+                std::vector<cuBool_Index> rows(nvals);
+                std::vector<cuBool_Index> cols(nvals);
+                CUBOOL_CHECK(cuBool_Matrix_ExtractPairs(R, rows.data(), cols.data(), &nvals));
+                auto fingerprint = fingerprintCoo(nvals, rows.data(), cols.data());
+
+                auto& entry = argsProcessor.getEntries()[experimentIdx];
+                bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":A+AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+                addMetric("nvals", (double) nvals);
+                addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
-                log << "   Result matrix: size: " << nrows << " x " << ncols << " nvals: " << nvals << std::endl;
+                log << "   Result matrix: size: " << nrows << " x " << ncols << " nvals: " << nvals
+                    << " fingerprint: " << fingerprint.toString() << std::endl;
 #endif // BENCH_DEBUG
 
                 CUBOOL_CHECK(cuBool_Matrix_Free(R));
@@ -130,6 +161,8 @@ namespace benchmark {
 
     protected:
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
 
         cuBool_Matrix A = nullptr;
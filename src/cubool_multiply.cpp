@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 #include <cubool/cubool.h>
 
@@ -41,6 +44,12 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "Cubool-Multiply";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -67,6 +76,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -108,8 +122,21 @@ namespace benchmark {
                 CUBOOL_CHECK(cuBool_Matrix_Ncols(result, &ncols));
                 CUBOOL_CHECK(cuBool_Matrix_Nvals(result, &nvals));
 
+                // Fingerprint is computed on the host copy, outside of measured region
+                std::vector<cuBool_Index> rows(nvals);
+                std::vector<cuBool_Index> cols(nvals);
+                CUBOOL_CHECK(cuBool_Matrix_ExtractPairs(result, rows.data(), cols.data(), &nvals));
+                auto fingerprint = fingerprintCoo(nvals, rows.data(), cols.data());
+
+                auto& entry = argsProcessor.getEntries()[experimentIdx];
+                bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+                addMetric("nvals", (double) nvals);
+                addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
-                log << "   Result matrix: size: " << nrows << " x " << ncols << " nvals: " << nvals << std::endl;
+                log << "   Result matrix: size: " << nrows << " x " << ncols << " nvals: " << nvals
+                    << " fingerprint: " << fingerprint.toString() << std::endl;
 #endif // BENCH_DEBUG
 
                 CUBOOL_CHECK(cuBool_Matrix_Free(result));
@@ -121,6 +148,8 @@ namespace benchmark {
 
     protected:
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
 
         cuBool_Matrix matrix = nullptr;
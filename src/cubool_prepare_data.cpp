@@ -46,6 +46,12 @@ int main(int argc, const char** argv) {
         const auto& file = entry.name;
         const auto& type = entry.isUndirected;
 
+        // A^2 file name is derived from the source file, generator specs have none (see MatrixLoader2)
+        if (entry.isGenerated()) {
+            std::cerr << "Skip generator spec, A^2 files are not written for it: " << file << std::endl;
+            continue;
+        }
+
         MatrixLoader loader(file, type);
         loader.loadData();
         input = std::move(loader.getMatrix());
@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 #include <cusp_compiler_fence.hpp>
 #include <cusp/csr_matrix.h>
@@ -69,6 +72,12 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "Cusp-Multiply";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -95,6 +104,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -134,9 +148,20 @@ namespace benchmark {
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Fingerprint is computed on the host copy, outside of measured region
+            host_csr_matrix_t r(R);
+            auto fingerprint = fingerprintCsr(r.num_rows, thrust::raw_pointer_cast(r.row_offsets.data()),
+                                              thrust::raw_pointer_cast(r.column_indices.data()));
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << R.num_rows << " x " << R.num_cols
-                << " nvals " << R.num_entries << std::endl;
+                << " nvals " << R.num_entries << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             R = device_matrix_t{};
@@ -145,11 +170,14 @@ namespace benchmark {
     protected:
         typedef cusp::coo_matrix<int, value_type, cusp::host_memory> host_matrix_t;
         typedef cusp::csr_matrix<int, value_type, cusp::device_memory> device_matrix_t;
+        typedef cusp::csr_matrix<int, value_type, cusp::host_memory> host_csr_matrix_t;
 
         host_matrix_t hostData;
         device_matrix_t matrix;
         device_matrix_t R;
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
         Matrix input;
     };
@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
@@ -67,6 +70,12 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "cuSPARSE-Multiply";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -94,6 +103,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log       << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                       << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals
@@ -182,9 +196,20 @@ namespace benchmark {
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Fingerprint is computed on the host copy, outside of measured region
+            thrust::host_vector<int> rows = R.rows;
+            thrust::host_vector<int> cols = R.cols;
+            auto fingerprint = fingerprintCsr(R.n, rows.data(), cols.data());
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << R.n << " x " << R.n
-                << " nvals " << R.nvals << std::endl;
+                << " nvals " << R.nvals << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             CUSPARSE_CHECH(cusparseDestroyMatDescr(R.desc));
@@ -199,6 +224,8 @@ namespace benchmark {
         CsrMatrix R;
         thrust::device_vector<float> values;
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
         Matrix input;
 
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <args_processor.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_writer.hpp>
+#include <matrix_generator.hpp>
+#include <filesystem>
+
+using namespace benchmark;
+
+// Materializes config entries as files: generator specs are written under --output dir,
+// existing .mtx files are converted next to the source file.
+// With --square precomputed A^2 files (.mtx2 loaded by MatrixLoader2) are converted as well.
+int main(int argc, const char** argv) {
+    ArgsProcessor argsProcessor;
+    Matrix input;
+
+    argsProcessor.parse(argc, argv);
+    assert(argsProcessor.isParsed());
+
+    auto format = argsProcessor.getOption("format", "csr");
+    auto output = argsProcessor.getOption("output", "data/generated");
+    auto square = argsProcessor.hasOption("square");
+    assert(format == "csr" || format == "csrz" || format == "mtx");
+
+    auto save = [&](const std::string& path, const Matrix& m) {
+        MatrixWriter writer;
+
+        if (format == "csr")
+            writer.saveCsr(path, m);
+        else if (format == "csrz")
+            writer.saveCsrz(path, m);
+        else
+            writer.save(path, m);
+
+        if (!writer.error.empty()) {
+            std::cerr << writer.error << ": " << path << std::endl;
+            return false;
+        }
+
+        std::cout << "Write matrix " << path << " : size: " << m.nrows << " x " << m.ncols << " nvals: " << m.nvals << std::endl;
+        return true;
+    };
+
+    for (auto& entry: argsProcessor.getEntries()) {
+        const auto& file = entry.name;
+        const auto& type = entry.isUndirected;
+
+        MatrixLoader loader(file, type);
+        loader.loadData();
+        input = std::move(loader.getMatrix());
+
+        std::string path;
+
+        if (entry.isGenerated()) {
+            path = file;
+            std::replace(path.begin(), path.end(), ':', '_');
+            std::replace(path.begin(), path.end(), '=', '-');
+            std::replace(path.begin(), path.end(), ',', '_');
+            path = output + "/" + path + (type? "-undirected": "");
+            std::filesystem::create_directories(output);
+        }
+        else {
+            auto extension = file.rfind('.');
+            path = extension == std::string::npos? file: file.substr(0, extension);
+        }
+
+        path += "." + format;
+
+        if (!save(path, input))
+            return 1;
+
+        if (square && !entry.isGenerated()) {
+            MatrixLoader2 loader2(file);
+            loader2.loadData();
+
+            if (!save(path + "2", loader2.getMatrix()))
+                return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_GRAMMAR_HPP
+#define SPBENCH_GRAMMAR_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <exception>
+#include <unordered_map>
+#include <cassert>
+
+namespace benchmark {
+
+    /**
+     * Context-free grammar in weak Chomsky normal form for CFPQ.
+     *
+     * Text format: one rule per line, `%` starts a comment line.
+     *   N -> A B   binary rule, A and B are nonterminals
+     *   N -> a     terminal rule, a is edge label
+     *   N -> eps   epsilon rule
+     * Nonterminals are the symbols on the left side of rules, start nonterminal is the left side of the first rule.
+     */
+    class Grammar {
+    public:
+
+        struct BinaryRule {
+            size_t left;
+            size_t first;
+            size_t second;
+        };
+
+        struct TerminalRule {
+            size_t left;
+            std::string terminal;
+        };
+
+        Grammar() = default;
+
+        explicit Grammar(std::string path) : path(std::move(path)) {
+
+        }
+
+        /** Attempts to load grammar, throws if grammar is not in weak CNF */
+        void loadData() {
+            assert(!loaded);
+
+            std::ifstream file;
+            file.open(path, std::ios_base::in);
+
+            if (!file.is_open()) {
+                error = "Failed to open file " + path;
+                throw std::runtime_error(error);
+            }
+
+            std::vector<std::vector<std::string>> rules;
+            std::string line;
+
+            while (std::getline(file, line)) {
+                std::stringstream lineStream(line);
+                std::vector<std::string> tokens;
+                std::string token;
+
+                while (lineStream >> token) {
+                    tokens.push_back(token);
+                }
+
+                if (tokens.empty() || tokens[0][0] == '%')
+                    continue;
+
+                if (tokens.size() < 3 || tokens.size() > 4 || tokens[1] != "->") {
+                    error = "Invalid rule: " + line;
+                    throw std::runtime_error(error);
+                }
+
+                getNonterminal(tokens[0]);
+                rules.push_back(std::move(tokens));
+            }
+
+            if (rules.empty()) {
+                error = "No rules in grammar " + path;
+                throw std::runtime_error(error);
+            }
+
+            for (auto& rule: rules) {
+                auto left = mIds[rule[0]];
+
+                if (rule.size() == 4) {
+                    if (!isNonterminal(rule[2]) || !isNonterminal(rule[3])) {
+                        error = "Binary rule of " + rule[0] + " must have nonterminals on the right side";
+                        throw std::runtime_error(error);
+                    }
+
+                    binaryRules.push_back({ left, mIds[rule[2]], mIds[rule[3]] });
+                }
+                else if (rule[2] == "eps") {
+                    epsRules.push_back(left);
+                }
+                else {
+                    if (isNonterminal(rule[2])) {
+                        error = "Unit rule " + rule[0] + " -> " + rule[2] + " is not allowed in weak CNF";
+                        throw std::runtime_error(error);
+                    }
+
+                    terminalRules.push_back({ left, rule[2] });
+                }
+            }
+
+            loaded = true;
+        }
+
+        bool isLoaded() const {
+            return loaded;
+        }
+
+        bool isNonterminal(const std::string& symbol) const {
+            return mIds.find(symbol) != mIds.end();
+        }
+
+        size_t getNonterminalsCount() const {
+            return nonterminals.size();
+        }
+
+        const std::string& getNonterminal(size_t id) const {
+            return nonterminals[id];
+        }
+
+        size_t getStart() const {
+            return 0;
+        }
+
+        const std::vector<size_t>& getEpsRules() const {
+            return epsRules;
+        }
+
+        const std::vector<TerminalRule>& getTerminalRules() const {
+            return terminalRules;
+        }
+
+        const std::vector<BinaryRule>& getBinaryRules() const {
+            return binaryRules;
+        }
+
+    private:
+
+        size_t getNonterminal(const std::string& symbol) {
+            auto found = mIds.find(symbol);
+            if (found != mIds.end())
+                return found->second;
+
+            nonterminals.push_back(symbol);
+            return mIds[symbol] = nonterminals.size() - 1;
+        }
+
+        bool loaded = false;
+        std::string path;
+        std::string error;
+        std::vector<std::string> nonterminals;
+        std::unordered_map<std::string, size_t> mIds;
+        std::vector<size_t> epsRules;
+        std::vector<TerminalRule> terminalRules;
+        std::vector<BinaryRule> binaryRules;
+    };
+
+}
+
+#endif //SPBENCH_GRAMMAR_HPP
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_LABELED_GRAPH_LOADER_HPP
+#define SPBENCH_LABELED_GRAPH_LOADER_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <exception>
+#include <algorithm>
+#include <cassert>
+#include <matrix.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_generator.hpp>
+#include <matrix_writer.hpp>
+
+namespace benchmark {
+
+    /**
+     * Loads edge-labeled graph as the set of boolean matrices, one matrix per label.
+     *
+     * Path is either matrix (`.mtx`, `.csr`, `.csrz` file or generator spec), which gives single label `a`,
+     * or graph description text file, where each line is `label path/to/label.mtx isUndirected`
+     * (`%` starts a comment line).
+     * For each label `x` reversed label `x_r` (transposed matrix) is added too.
+     * All matrices are resized to the same n x n shape.
+     */
+    class LabeledGraphLoader {
+    public:
+
+        struct Label {
+            std::string name;
+            Matrix matrix;
+        };
+
+        explicit LabeledGraphLoader(std::string path, bool isUndirected = false)
+                : path(std::move(path)), isUndirected(isUndirected) {
+
+        }
+
+        /** Attempts to load data */
+        void loadData() {
+            assert(!loaded);
+
+            if (isMatrixPath(path)) {
+                addLabel("a", path, isUndirected);
+            }
+            else {
+                std::ifstream file;
+                file.open(path, std::ios_base::in);
+
+                if (!file.is_open()) {
+                    error = "Failed to open file " + path;
+                    throw std::runtime_error(error);
+                }
+
+                std::string line;
+
+                while (std::getline(file, line)) {
+                    if (line.empty() || line[0] == '%')
+                        continue;
+
+                    std::string name;
+                    std::string labelPath;
+                    int undirected = 0;
+
+                    std::stringstream lineStream(line);
+                    lineStream >> name >> labelPath >> undirected;
+
+                    addLabel(name, labelPath, undirected != 0);
+                }
+            }
+
+            for (auto& label: labels) {
+                n = std::max(n, std::max(label.matrix.nrows, label.matrix.ncols));
+            }
+
+            for (auto& label: labels) {
+                label.matrix.nrows = n;
+                label.matrix.ncols = n;
+            }
+
+            loaded = true;
+        }
+
+        bool isLoaded() const {
+            return loaded;
+        }
+
+        size_t getVerticesCount() const {
+            return n;
+        }
+
+        const std::vector<Label>& getLabels() const {
+            return labels;
+        }
+
+    private:
+
+        /** @return True if path is loaded by MatrixLoader as is, rather than being the graph description file */
+        static bool isMatrixPath(const std::string& path) {
+            const std::string mtx = ".mtx";
+
+            return (path.size() >= mtx.size() && path.compare(path.size() - mtx.size(), mtx.size(), mtx) == 0) ||
+                   MatrixGenerator::isSpec(path) ||
+                   MatrixWriter::isCsrFile(path) ||
+                   MatrixWriter::isCsrzFile(path);
+        }
+
+        void addLabel(const std::string& name, const std::string& file, bool undirected) {
+            MatrixLoader loader(file, undirected);
+            loader.loadData();
+
+            Label label{ name, loader.getMatrix() };
+            Label reversed{ name + "_r", label.matrix };
+
+            std::swap(reversed.matrix.rows, reversed.matrix.cols);
+            std::swap(reversed.matrix.nrows, reversed.matrix.ncols);
+
+            labels.push_back(std::move(label));
+            labels.push_back(std::move(reversed));
+        }
+
+        bool loaded = false;
+        std::string path;
+        bool isUndirected;
+        std::string error;
+        size_t n = 0;
+        std::vector<Label> labels;
+    };
+
+}
+
+#endif //SPBENCH_LABELED_GRAPH_LOADER_HPP
@@ -26,21 +26,47 @@
 #define SPBENCH_MATRIX_HPP
 
 #include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Boolean matrix in the basic coo format.
+ * @tparam Index Type of row and column indices: 32-bit is enough for most datasets,
+ *               64-bit is required if the matrix has more than 2^32 rows or columns
+ */
+template<typename Index>
+struct MatrixT {
+    using index_type = Index;
 
-struct Matrix {
     size_t nrows = 0;
     size_t ncols = 0;
     size_t nvals = 0;
-    std::vector<unsigned int> rows;
-    std::vector<unsigned int> cols;
+    std::vector<Index> rows;
+    std::vector<Index> cols;
+
+    MatrixT() = default;
+    MatrixT(const MatrixT& m) = default;
+    MatrixT(MatrixT&& m) noexcept = default;
+
+    MatrixT& operator=(const MatrixT& m) = default;
+    MatrixT& operator=(MatrixT&& m) noexcept = default;
+
+};
 
-    Matrix() = default;
-    Matrix(const Matrix& m) = default;
-    Matrix(Matrix&& m) noexcept = default;
+using Matrix = MatrixT<unsigned int>;
+using Matrix64 = MatrixT<uint64_t>;
 
-    Matrix& operator=(const Matrix& m) = default;
-    Matrix& operator=(Matrix&& m) noexcept = default;
+/** Shape of the matrix, known before its entries are loaded */
+struct MatrixShape {
+    size_t nrows = 0;
+    size_t ncols = 0;
+    size_t nvals = 0;
 
+    /** @return Bits of the narrowest index type (32 or 64), which can address all rows and columns */
+    unsigned int indexBits() const {
+        const uint64_t limit = (uint64_t) UINT32_MAX + 1;
+        return (uint64_t) nrows <= limit && (uint64_t) ncols <= limit ? 32 : 64;
+    }
 };
 
 #endif //SPBENCH_MATRIX_HPP
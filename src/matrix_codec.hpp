@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_MATRIX_CODEC_HPP
+#define SPBENCH_MATRIX_CODEC_HPP
+
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__CUDACC__)
+    #define SPBENCH_CODEC_SSSE3
+    #include <tmmintrin.h>
+#endif
+
+namespace benchmark {
+
+    namespace details {
+
+        /** Stream VByte decode tables: byte length and pshufb mask of 4 values for each control byte */
+        struct VByteTables {
+            uint8_t lengths[256];
+            uint8_t shuffles[256][16];
+
+            VByteTables() {
+                for (int c = 0; c < 256; c++) {
+                    int offset = 0;
+
+                    for (int i = 0; i < 4; i++) {
+                        int length = ((c >> (2 * i)) & 3) + 1;
+
+                        for (int b = 0; b < 4; b++) {
+                            shuffles[c][4 * i + b] = b < length? (uint8_t) (offset + b): 0xff;
+                        }
+
+                        offset += length;
+                    }
+
+                    lengths[c] = (uint8_t) offset;
+                }
+            }
+
+            static const VByteTables& get() {
+                static VByteTables tables;
+                return tables;
+            }
+        };
+
+        inline uint32_t vbyteCode(uint32_t value) {
+            return value > 0xffffff? 3: value > 0xffff? 2: value > 0xff? 1: 0;
+        }
+
+        /** Decodes full groups of 4 values one by one, values are stored little endian */
+        inline const uint8_t* vbyteDecodeScalar(const uint8_t* control, size_t groups, const uint8_t* data, uint32_t* out) {
+            static const uint32_t masks[4] = { 0xff, 0xffff, 0xffffff, 0xffffffff };
+
+            for (size_t g = 0; g < groups; g++) {
+                uint32_t c = control[g];
+
+                for (size_t i = 0; i < 4; i++) {
+                    uint32_t code = (c >> (2 * i)) & 3;
+                    uint32_t value;
+                    std::memcpy(&value, data, sizeof(value));
+                    out[4 * g + i] = value & masks[code];
+                    data += code + 1;
+                }
+            }
+
+            return data;
+        }
+
+#ifdef SPBENCH_CODEC_SSSE3
+        /** Decodes full groups of 4 values by a single shuffle each, compiled for ssse3 and chosen at runtime */
+        __attribute__((target("ssse3")))
+        inline const uint8_t* vbyteDecodeSsse3(const uint8_t* control, size_t groups, const uint8_t* data, uint32_t* out) {
+            const auto& tables = VByteTables::get();
+
+            for (size_t g = 0; g < groups; g++) {
+                uint8_t c = control[g];
+                __m128i bytes = _mm_loadu_si128((const __m128i*) data);
+                __m128i shuffle = _mm_loadu_si128((const __m128i*) tables.shuffles[c]);
+                _mm_storeu_si128((__m128i*) (out + 4 * g), _mm_shuffle_epi8(bytes, shuffle));
+                data += tables.lengths[c];
+            }
+
+            return data;
+        }
+
+        inline bool vbyteHasSsse3() {
+            static const bool supported = __builtin_cpu_supports("ssse3");
+            return supported;
+        }
+#endif
+
+        /**
+         * Stream VByte coded sequence of uint32 values: 2-bit byte lengths of 4 values are packed into one control byte,
+         * value bytes go into separate data stream, so a group of 4 values is decoded by a single shuffle.
+         * Values are split into chunks, data offset of each chunk is stored, so chunks are encoded and decoded in parallel.
+         */
+        class VByteStream {
+        public:
+            static const size_t CHUNK_SIZE = 1 << 14;
+            /** Zero bytes after data, so 16 bytes loads of the last groups stay in bounds */
+            static const size_t PADDING = 16;
+
+            void encode(const uint32_t* values, size_t n) {
+                size_t chunkSize = CHUNK_SIZE;
+                size_t chunksCount = (n + chunkSize - 1) / chunkSize;
+
+                count = n;
+                chunks.assign(chunksCount + 1, 0);
+                control.assign((n + 3) / 4, 0);
+
+#pragma omp parallel for schedule(dynamic, 16)
+                for (long long k = 0; k < (long long) chunksCount; k++) {
+                    size_t first = (size_t) k * chunkSize;
+                    size_t last = first + chunkSize < n? first + chunkSize: n;
+                    uint64_t bytes = 0;
+
+                    for (size_t i = first; i < last; i++) {
+                        uint32_t code = vbyteCode(values[i]);
+                        control[i / 4] |= (uint8_t) (code << (2 * (i % 4)));
+                        bytes += code + 1;
+                    }
+
+                    chunks[k + 1] = bytes;
+                }
+
+                for (size_t k = 0; k < chunksCount; k++) {
+                    chunks[k + 1] += chunks[k];
+                }
+
+                data.assign(chunks[chunksCount] + PADDING, 0);
+
+#pragma omp parallel for schedule(dynamic, 16)
+                for (long long k = 0; k < (long long) chunksCount; k++) {
+                    size_t first = (size_t) k * chunkSize;
+                    size_t last = first + chunkSize < n? first + chunkSize: n;
+                    uint8_t* p = data.data() + chunks[k];
+
+                    for (size_t i = first; i < last; i++) {
+                        uint32_t value = values[i];
+                        uint32_t length = vbyteCode(value) + 1;
+
+                        for (uint32_t b = 0; b < length; b++) {
+                            *(p++) = (uint8_t) (value >> (8 * b));
+                        }
+                    }
+                }
+            }
+
+            /** Decodes all values into out, which must have space for getCount() values */
+            void decode(uint32_t* out) const {
+                size_t chunkSize = CHUNK_SIZE;
+                size_t chunksCount = chunks.empty()? 0: chunks.size() - 1;
+
+#ifdef SPBENCH_CODEC_SSSE3
+                auto decodeGroups = vbyteHasSsse3()? vbyteDecodeSsse3: vbyteDecodeScalar;
+#else
+                auto decodeGroups = vbyteDecodeScalar;
+#endif
+
+#pragma omp parallel for schedule(dynamic, 16)
+                for (long long k = 0; k < (long long) chunksCount; k++) {
+                    size_t first = (size_t) k * chunkSize;
+                    size_t last = first + chunkSize < count? first + chunkSize: count;
+                    size_t groups = (last - first) / 4;
+
+                    const uint8_t* c = control.data() + first / 4;
+                    const uint8_t* p = decodeGroups(c, groups, data.data() + chunks[k], out + first);
+
+                    // Last group of the stream may be partial, it is decoded into temporary and trimmed
+                    if (first + 4 * groups < last) {
+                        uint32_t tail[4];
+                        vbyteDecodeScalar(c + groups, 1, p, tail);
+
+                        for (size_t i = first + 4 * groups; i < last; i++) {
+                            out[i] = tail[i - first - 4 * groups];
+                        }
+                    }
+                }
+            }
+
+            bool write(std::ostream& stream) const {
+                uint64_t header[2] = { count, chunks.empty()? 0: chunks.back() };
+
+                stream.write((const char*) header, sizeof(header));
+                stream.write((const char*) chunks.data(), (std::streamsize) (sizeof(uint64_t) * chunks.size()));
+                stream.write((const char*) control.data(), (std::streamsize) control.size());
+                stream.write((const char*) data.data(), (std::streamsize) header[1]);
+
+                return (bool) stream;
+            }
+
+            bool read(std::istream& stream) {
+                uint64_t header[2];
+                stream.read((char*) header, sizeof(header));
+
+                if (!stream)
+                    return false;
+
+                count = header[0];
+                chunks.resize((count + CHUNK_SIZE - 1) / CHUNK_SIZE + 1);
+                control.resize((count + 3) / 4);
+                data.assign(header[1] + PADDING, 0);
+
+                stream.read((char*) chunks.data(), (std::streamsize) (sizeof(uint64_t) * chunks.size()));
+                stream.read((char*) control.data(), (std::streamsize) control.size());
+                stream.read((char*) data.data(), (std::streamsize) header[1]);
+
+                if (!stream || chunks.front() != 0 || chunks.back() != header[1])
+                    return false;
+
+                // Chunks are decoded at their data offsets, so offsets must stay within the data
+                for (size_t k = 1; k < chunks.size(); k++) {
+                    if (chunks[k] < chunks[k - 1])
+                        return false;
+                }
+
+                return true;
+            }
+
+            size_t getCount() const {
+                return count;
+            }
+
+            /** @return Size of the serialized stream */
+            size_t getSizeBytes() const {
+                return 2 * sizeof(uint64_t) + sizeof(uint64_t) * chunks.size() + control.size() + (data.size() - PADDING);
+            }
+
+        private:
+            size_t count = 0;
+            std::vector<uint64_t> chunks{0};
+            std::vector<uint8_t> control;
+            std::vector<uint8_t> data = std::vector<uint8_t>(PADDING, 0);
+        };
+
+    }
+
+    /**
+     * Compressed csr pattern: row sizes and per-row deltas of sorted column indices are Stream VByte coded.
+     * First column of the row is stored as is, next ones as difference with the previous one.
+     * Neighbours of road-like and reordered graphs are close, so most of deltas take a single byte.
+     */
+    class CompressedCsr {
+    public:
+
+        /**
+         * @param offsets Row offsets, nrows + 1 entries
+         * @param cols Column indices sorted within rows without duplicates
+         */
+        void encode(size_t nrows, size_t ncols, const uint64_t* offsets, const uint32_t* cols) {
+            this->nrows = nrows;
+            this->ncols = ncols;
+            this->nvals = (size_t) (offsets[nrows] - offsets[0]);
+
+            std::vector<uint32_t> values(nrows);
+
+            for (size_t i = 0; i < nrows; i++) {
+                values[i] = (uint32_t) (offsets[i + 1] - offsets[i]);
+            }
+
+            rowSizes.encode(values.data(), nrows);
+
+            values.resize(nvals);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long i = 0; i < (long long) nrows; i++) {
+                uint32_t prev = 0;
+
+                for (auto k = offsets[i]; k < offsets[i + 1]; k++) {
+                    assert(k == offsets[i] || cols[k] > prev);
+                    values[k - offsets[0]] = cols[k] - prev;
+                    prev = cols[k];
+                }
+            }
+
+            colDeltas.encode(values.data(), nvals);
+        }
+
+        /** Decodes csr, offsets and cols are resized as needed */
+        void decode(std::vector<uint64_t>& offsets, std::vector<uint32_t>& cols) const {
+            std::vector<uint32_t> sizes(nrows);
+            rowSizes.decode(sizes.data());
+
+            offsets.resize(nrows + 1);
+            offsets[0] = 0;
+
+            for (size_t i = 0; i < nrows; i++) {
+                offsets[i + 1] = offsets[i] + sizes[i];
+            }
+
+            cols.resize(nvals);
+            colDeltas.decode(cols.data());
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long i = 0; i < (long long) nrows; i++) {
+                for (auto k = offsets[i] + 1; k < offsets[i + 1]; k++) {
+                    cols[k] += cols[k - 1];
+                }
+            }
+        }
+
+        /** Writes header (nrows, ncols, nvals) and both streams */
+        bool write(std::ostream& stream) const {
+            uint64_t header[3] = { nrows, ncols, nvals };
+            stream.write((const char*) header, sizeof(header));
+            return rowSizes.write(stream) && colDeltas.write(stream);
+        }
+
+        bool read(std::istream& stream) {
+            uint64_t header[3];
+            stream.read((char*) header, sizeof(header));
+
+            if (!stream)
+                return false;
+
+            nrows = header[0];
+            ncols = header[1];
+            nvals = header[2];
+
+            return rowSizes.read(stream) && colDeltas.read(stream) &&
+                   rowSizes.getCount() == nrows && colDeltas.getCount() == nvals;
+        }
+
+        size_t getNrows() const {
+            return nrows;
+        }
+
+        size_t getNcols() const {
+            return ncols;
+        }
+
+        size_t getNvals() const {
+            return nvals;
+        }
+
+        /** @return Size of the serialized matrix */
+        size_t getSizeBytes() const {
+            return 3 * sizeof(uint64_t) + rowSizes.getSizeBytes() + colDeltas.getSizeBytes();
+        }
+
+    private:
+        size_t nrows = 0;
+        size_t ncols = 0;
+        size_t nvals = 0;
+        details::VByteStream rowSizes;
+        details::VByteStream colDeltas;
+    };
+
+}
+
+#endif //SPBENCH_MATRIX_CODEC_HPP
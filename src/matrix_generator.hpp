@@ -0,0 +1,444 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_MATRIX_GENERATOR_HPP
+#define SPBENCH_MATRIX_GENERATOR_HPP
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <map>
+#include <matrix.hpp>
+
+namespace benchmark {
+
+    namespace details {
+
+        /** Counter based splitmix64 stream, portable across std libs, so generated datasets are identical everywhere */
+        class GenRandom {
+        public:
+            GenRandom(uint64_t seed, uint64_t stream) {
+                state = mix(seed + 0x9e3779b97f4a7c15ull * (stream + 1));
+            }
+
+            uint64_t next() {
+                state += 0x9e3779b97f4a7c15ull;
+                return mix(state);
+            }
+
+            /** @return Uniform value in [0, 1) */
+            double nextDouble() {
+                return (double) (next() >> 11) * (1.0 / 9007199254740992.0);
+            }
+
+            /** @return Uniform value in [0, n) */
+            uint64_t nextBelow(uint64_t n) {
+                return next() % n;
+            }
+
+        private:
+            static uint64_t mix(uint64_t z) {
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+
+            uint64_t state;
+        };
+
+        using GenPair = std::pair<unsigned int, unsigned int>;
+
+        /**
+         * Sorts pairs by (row, col) and removes duplicates in parallel.
+         * Pairs are bucketed by row with counting sort, then each row is sorted on its own,
+         * so the result does not depend on the threads count.
+         */
+        template<typename Index>
+        inline void sortUnique(std::vector<std::pair<Index, Index>>& pairs, size_t nrows) {
+            std::vector<size_t> offsets(nrows + 1, 0);
+
+            for (const auto& p: pairs) {
+                offsets[p.first + 1] += 1;
+            }
+            for (size_t i = 0; i < nrows; i++) {
+                offsets[i + 1] += offsets[i];
+            }
+
+            std::vector<Index> cols(pairs.size());
+            std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+
+            for (const auto& p: pairs) {
+                cols[fill[p.first]++] = p.second;
+            }
+
+            std::vector<size_t> unique(nrows + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long i = 0; i < (long long) nrows; i++) {
+                auto first = cols.begin() + offsets[i];
+                auto last = cols.begin() + offsets[i + 1];
+                std::sort(first, last);
+                unique[i + 1] = std::unique(first, last) - first;
+            }
+
+            for (size_t i = 0; i < nrows; i++) {
+                unique[i + 1] += unique[i];
+            }
+
+            pairs.resize(unique[nrows]);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long i = 0; i < (long long) nrows; i++) {
+                for (size_t k = 0; k < unique[i + 1] - unique[i]; k++) {
+                    pairs[unique[i] + k] = std::pair<Index, Index>((Index) i, cols[offsets[i] + k]);
+                }
+            }
+        }
+
+    }
+
+    /**
+     * Deterministic synthetic graph generator.
+     *
+     * Spec syntax is `gen:<kind>:<key>=<value>:...`, for example `gen:rmat:scale=24:ef=16:seed=7`.
+     * Supported kinds:
+     *  - rmat: R-MAT/Graph500 with n = 2^scale, ef * n edges, quadrant probabilities a, b, c (d = 1 - a - b - c),
+     *          vertex ids are scrambled with a seeded permutation unless permute=0;
+     *  - er: uniform random (Erdős–Rényi G(n, m)) with n vertices (or scale) and ef * n edges;
+     *  - grid: road-like rows x cols 2D lattice, each lattice edge dropped with probability drop,
+     *          each vertex gets a shortcut to a random vertex within radius r with probability p;
+     *  - kronecker: stochastic Kronecker graph for k x k initiator init=v0,v1,... (row-major),
+     *          n = k^scale, ef * n edges.
+     *
+     * Edges are generated in fixed size chunks, each chunk has its own random stream derived from seed,
+     * so the result depends only on the spec, not on the threads count.
+     */
+    class MatrixGenerator {
+    public:
+
+        using pair = details::GenPair;
+
+        static const size_t CHUNK_SIZE = 1 << 16;
+
+        /**
+         * @param spec Generator spec string `gen:<kind>:...`
+         * @param isUndirected True if generated edges must be duplicated in both directions
+         */
+        explicit MatrixGenerator(std::string spec, bool isUndirected = false)
+                : spec(std::move(spec)), isUndirected(isUndirected) {
+            parse();
+        }
+
+        /** @return True if name is a generator spec rather than a file path */
+        static bool isSpec(const std::string& name) {
+            return name.compare(0, 4, "gen:") == 0;
+        }
+
+        /** Throws std::runtime_error if the spec is malformed */
+        static void validate(const std::string& spec) {
+            MatrixGenerator generator(spec);
+        }
+
+        size_t getNrows() const {
+            return n;
+        }
+
+        /** @return Sorted by (row, col) unique edges */
+        std::vector<pair> generatePairs() const {
+            std::vector<pair> pairs;
+
+            if (kind == "grid")
+                generateGrid(pairs);
+            else
+                generateEdges(pairs);
+
+            if (isUndirected) {
+                size_t count = pairs.size();
+                pairs.reserve(count * 2);
+                for (size_t i = 0; i < count; i++) {
+                    pairs.emplace_back(pairs[i].second, pairs[i].first);
+                }
+            }
+
+            details::sortUnique(pairs, n);
+            return pairs;
+        }
+
+        /** @return Generated matrix in the basic coo format with sorted unique entries */
+        Matrix generate() const {
+            auto pairs = generatePairs();
+
+            Matrix matrix;
+            matrix.nrows = n;
+            matrix.ncols = n;
+            matrix.nvals = pairs.size();
+            matrix.rows.reserve(pairs.size());
+            matrix.cols.reserve(pairs.size());
+
+            for (const auto& p: pairs) {
+                matrix.rows.push_back(p.first);
+                matrix.cols.push_back(p.second);
+            }
+
+            return matrix;
+        }
+
+    private:
+
+        void parse() {
+            std::vector<std::string> parts;
+            std::stringstream stream(spec);
+            std::string part;
+
+            while (std::getline(stream, part, ':')) {
+                parts.push_back(part);
+            }
+
+            if (parts.size() < 2 || parts[0] != "gen")
+                fail("expected gen:<kind>:<key>=<value>...");
+
+            kind = parts[1];
+
+            for (size_t i = 2; i < parts.size(); i++) {
+                auto separator = parts[i].find('=');
+                if (separator == std::string::npos)
+                    fail("expected <key>=<value> in \"" + parts[i] + "\"");
+
+                params[parts[i].substr(0, separator)] = parts[i].substr(separator + 1);
+            }
+
+            seed = (uint64_t) std::stoull(param("seed", "1"));
+            ef = std::stod(param("ef", "16"));
+
+            if (kind == "rmat") {
+                scale = (unsigned int) std::stoul(param("scale", ""));
+                a = std::stod(param("a", "0.57"));
+                b = std::stod(param("b", "0.19"));
+                c = std::stod(param("c", "0.19"));
+                permute = param("permute", "1") != "0";
+                if (a < 0 || b < 0 || c < 0 || a + b + c > 1.0)
+                    fail("expected a, b, c >= 0 and a + b + c <= 1");
+                initiator = {a, b, c, 1.0 - a - b - c};
+                k = 2;
+                n = checkedPower(2, scale);
+            }
+            else if (kind == "er") {
+                n = params.count("scale")? checkedPower(2, (unsigned int) std::stoul(param("scale", ""))): (size_t) std::stoull(param("n", ""));
+            }
+            else if (kind == "grid") {
+                rows = (size_t) std::stoull(param("rows", ""));
+                cols = (size_t) std::stoull(param("cols", param("rows", "")));
+                p = std::stod(param("p", "0.01"));
+                drop = std::stod(param("drop", "0.0"));
+                radius = (size_t) std::stoull(param("r", "4"));
+                n = rows * cols;
+            }
+            else if (kind == "kronecker") {
+                std::stringstream values(param("init", "0.9,0.5,0.5,0.1"));
+                std::string value;
+                while (std::getline(values, value, ',')) {
+                    initiator.push_back(std::stod(value));
+                }
+                k = (size_t) std::llround(std::sqrt((double) initiator.size()));
+                if (k < 2 || k * k != initiator.size())
+                    fail("expected k x k initiator with k >= 2");
+                scale = (unsigned int) std::stoul(param("scale", ""));
+                permute = param("permute", "0") != "0";
+                n = checkedPower(k, scale);
+            }
+            else {
+                fail("unknown kind \"" + kind + "\"");
+            }
+
+            if (n == 0 || n > (size_t) UINT32_MAX)
+                fail("matrix size must be in [1, 2^32)");
+
+            // Prefix sums of normalized initiator are used for per level cell sampling
+            double total = 0.0;
+            for (auto v: initiator) {
+                if (v < 0)
+                    fail("expected non-negative initiator");
+                total += v;
+            }
+            for (size_t i = 0; i < initiator.size(); i++) {
+                cumulative.push_back((i > 0? cumulative.back(): 0.0) + initiator[i] / total);
+            }
+        }
+
+        std::string param(const std::string& key, const std::string& defaultValue) const {
+            auto found = params.find(key);
+
+            if (found != params.end())
+                return found->second;
+            if (defaultValue.empty())
+                fail("missing parameter \"" + key + "\"");
+
+            return defaultValue;
+        }
+
+        size_t checkedPower(size_t base, unsigned int exponent) const {
+            size_t result = 1;
+            for (unsigned int i = 0; i < exponent; i++) {
+                if (result > (size_t) UINT32_MAX / base)
+                    fail("matrix size does not fit unsigned int indices");
+                result *= base;
+            }
+            return result;
+        }
+
+        void fail(const std::string& message) const {
+            throw std::runtime_error("Invalid generator spec \"" + spec + "\": " + message);
+        }
+
+        /** Edge list generators: rmat, er and kronecker */
+        void generateEdges(std::vector<pair>& pairs) const {
+            size_t edges = (size_t) std::llround(ef * (double) n);
+            size_t chunks = (edges + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+            bool uniform = kind == "er";
+
+            pairs.resize(edges);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long chunk = 0; chunk < (long long) chunks; chunk++) {
+                details::GenRandom random(seed, (uint64_t) chunk);
+
+                size_t first = (size_t) chunk * CHUNK_SIZE;
+                size_t last = std::min(edges, first + CHUNK_SIZE);
+
+                for (size_t e = first; e < last; e++) {
+                    if (uniform) {
+                        pairs[e] = pair((unsigned int) random.nextBelow(n), (unsigned int) random.nextBelow(n));
+                        continue;
+                    }
+
+                    // Descend by levels, at each level select initiator cell (i, j)
+                    size_t row = 0, col = 0;
+                    for (unsigned int level = 0; level < scale; level++) {
+                        double u = random.nextDouble();
+                        size_t cell = std::upper_bound(cumulative.begin(), cumulative.end() - 1, u) - cumulative.begin();
+                        row = row * k + cell / k;
+                        col = col * k + cell % k;
+                    }
+
+                    pairs[e] = pair((unsigned int) row, (unsigned int) col);
+                }
+            }
+
+            if (permute) {
+                // Graph500 style scramble, hides locality of the recursive construction
+                std::vector<unsigned int> perm(n);
+                for (size_t i = 0; i < n; i++) {
+                    perm[i] = (unsigned int) i;
+                }
+
+                details::GenRandom random(seed, UINT64_MAX);
+                for (size_t i = n - 1; i > 0; i--) {
+                    std::swap(perm[i], perm[random.nextBelow(i + 1)]);
+                }
+
+#pragma omp parallel for
+                for (long long e = 0; e < (long long) edges; e++) {
+                    pairs[e] = pair(perm[pairs[e].first], perm[pairs[e].second]);
+                }
+            }
+        }
+
+        /** Road-like lattice with dropped edges and local shortcuts, edges are always symmetric */
+        void generateGrid(std::vector<pair>& pairs) const {
+            std::vector<std::vector<pair>> perRow(rows);
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (long long i = 0; i < (long long) rows; i++) {
+                details::GenRandom random(seed, (uint64_t) i);
+                auto& out = perRow[i];
+
+                for (size_t j = 0; j < cols; j++) {
+                    auto v = (unsigned int) (i * cols + j);
+
+                    if (j + 1 < cols && random.nextDouble() >= drop) {
+                        out.emplace_back(v, v + 1);
+                        out.emplace_back(v + 1, v);
+                    }
+                    if ((size_t) i + 1 < rows && random.nextDouble() >= drop) {
+                        out.emplace_back(v, (unsigned int) (v + cols));
+                        out.emplace_back((unsigned int) (v + cols), v);
+                    }
+                    if (radius > 0 && random.nextDouble() < p) {
+                        size_t width = 2 * radius + 1;
+                        long long ti = (long long) i + (long long) random.nextBelow(width) - (long long) radius;
+                        long long tj = (long long) j + (long long) random.nextBelow(width) - (long long) radius;
+                        ti = std::max(0ll, std::min((long long) rows - 1, ti));
+                        tj = std::max(0ll, std::min((long long) cols - 1, tj));
+
+                        auto u = (unsigned int) (ti * (long long) cols + tj);
+                        if (u != v) {
+                            out.emplace_back(v, u);
+                            out.emplace_back(u, v);
+                        }
+                    }
+                }
+            }
+
+            for (auto& out: perRow) {
+                pairs.insert(pairs.end(), out.begin(), out.end());
+                std::vector<pair>().swap(out);
+            }
+        }
+
+    private:
+        std::string spec;
+        std::string kind;
+        std::map<std::string, std::string> params;
+        bool isUndirected;
+
+        uint64_t seed = 1;
+        double ef = 16.0;
+        size_t n = 0;
+
+        // rmat and kronecker
+        unsigned int scale = 0;
+        size_t k = 2;
+        double a = 0.0, b = 0.0, c = 0.0;
+        bool permute = false;
+        std::vector<double> initiator;
+        std::vector<double> cumulative;
+
+        // grid
+        size_t rows = 0;
+        size_t cols = 0;
+        double p = 0.0;
+        double drop = 0.0;
+        size_t radius = 0;
+    };
+
+}
+
+#endif //SPBENCH_MATRIX_GENERATOR_HPP
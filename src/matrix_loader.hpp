@@ -34,20 +34,32 @@
 #include <cassert>
 #include <unordered_set>
 #include <matrix.hpp>
+#include <matrix_generator.hpp>
+#include <matrix_writer.hpp>
 #include <exception>
 #include <cmath>
+#include <cstdint>
 
 namespace benchmark {
 
-    class MatrixLoader {
+    /**
+     * Loader of the boolean matrix data.
+     * @tparam Index Type of row and column indices of the loaded matrix (see MatrixT),
+     *               use readShape to pick the narrowest one before loading
+     */
+    template<typename Index>
+    class MatrixLoaderT {
     public:
 
         /**
          * Load matrix data from Matrix Market file format.
-         * @param path Path to the file
+         * Paths with `.csr` extension are read in the binary csr format (see MatrixWriter::saveCsr),
+         * paths with `.csrz` extension are read in the compressed csr format (see MatrixWriter::saveCsrz),
+         * names `gen:<kind>:...` are generated in memory (see MatrixGenerator).
+         * @param path Path to the file or generator spec
          * @param isUndirected True if graph in the matrix is undirected, and edges must be duplicated
          */
-        explicit MatrixLoader(std::string path, bool isUndirected = false)
+        explicit MatrixLoaderT(std::string path, bool isUndirected = false)
                 : path(std::move(path)), isUndirected(isUndirected) {
 
         }
@@ -56,6 +68,29 @@ namespace benchmark {
         void loadData() {
             assert(!loaded);
 
+            if (MatrixGenerator::isSpec(path)) {
+                MatrixGenerator generator(path, isUndirected);
+                auto generated = generator.generatePairs();
+                takePairs(generated, pairs);
+                nrows = ncols = generator.getNrows();
+                nvals = nvalsInFile = pairs.size();
+
+                loaded = true;
+                collectStats();
+                return;
+            }
+
+            if (MatrixWriter::isCsrFile(path) || MatrixWriter::isCsrzFile(path)) {
+                if (MatrixWriter::isCsrFile(path))
+                    loadCsr();
+                else
+                    loadCsrz();
+
+                loaded = true;
+                collectStats();
+                return;
+            }
+
             std::ifstream file;
             file.open(path, std::ios_base::in);
 
@@ -78,7 +113,7 @@ namespace benchmark {
 
             struct Hash {
                 size_t operator()(const pair& p) const {
-                    return std::hash<unsigned int>()(p.first) + std::hash<unsigned int>()(p.second);
+                    return std::hash<Index>()(p.first) + std::hash<Index>()(p.second);
                 }
             };
 
@@ -93,10 +128,10 @@ namespace benchmark {
             nvals = isUndirected? nvalsInFile * 2: nvalsInFile;
             pairsSet.reserve(nvals);
 
-            for (auto i = 0; i < nvalsInFile; i++) {
+            for (size_t i = 0; i < nvalsInFile; i++) {
                 std::getline(file, line);
 
-                unsigned int rowid, colid;
+                Index rowid, colid;
 
                 lineStream = std::stringstream(line);
                 lineStream >> rowid;
@@ -163,6 +198,8 @@ namespace benchmark {
                 }
             }
 
+            maxNnzRow = std::max(currentMaxNnzRow, maxNnzRow);
+
             std::cout << "Matrix file: " << path << std::endl
                       << "Shape: " << nrows << "x" << ncols << std::endl
                       << "Total Nnz: " << totalNnz << std::endl
@@ -171,8 +208,8 @@ namespace benchmark {
         }
 
         /** @return Converted read data to basic coo matrix */
-        Matrix getMatrix() const {
-            Matrix matrix;
+        MatrixT<Index> getMatrix() const {
+            MatrixT<Index> matrix;
             matrix.nrows = nrows;
             matrix.ncols = ncols;
             matrix.nvals = nvals;
@@ -190,9 +227,162 @@ namespace benchmark {
             return std::move(matrix);
         }
 
+        /**
+         * Reads only the shape of the matrix: size line of Matrix Market file, header of binary file or generator spec.
+         * Number of entries is the one stored in the file, before symmetrization and duplicates removal,
+         * it is not known for generator specs without generation and is left zero.
+         */
+        static MatrixShape readShape(const std::string& path) {
+            MatrixShape shape;
+
+            if (MatrixGenerator::isSpec(path)) {
+                MatrixGenerator generator(path);
+                shape.nrows = shape.ncols = generator.getNrows();
+                return shape;
+            }
+
+            std::ifstream file;
+
+            if (MatrixWriter::isCsrFile(path) || MatrixWriter::isCsrzFile(path)) {
+                file.open(path, std::ios_base::in | std::ios_base::binary);
+
+                char magic[8];
+                uint64_t header[3];
+
+                file.read(magic, sizeof(magic));
+                file.read((char*) header, sizeof(header));
+
+                if (!file)
+                    throw std::runtime_error("Invalid binary csr file");
+
+                shape.nrows = header[0];
+                shape.ncols = header[1];
+                shape.nvals = header[2];
+                return shape;
+            }
+
+            file.open(path, std::ios_base::in);
+
+            if (!file.is_open())
+                throw std::runtime_error("Failed to open file");
+
+            std::string line;
+
+            do {
+                std::getline(file, line);
+            } while (file && line[0] == '%');
+
+            std::stringstream lineStream(line);
+            lineStream >> shape.nrows >> shape.ncols >> shape.nvals;
+            return shape;
+        }
+
     private:
 
-        using pair = std::pair<unsigned int, unsigned int>;
+        using pair = std::pair<Index, Index>;
+
+        template<typename P>
+        static void takePairs(std::vector<P>& source, std::vector<P>& target) {
+            target.swap(source);
+        }
+
+        /** Generator produces 32-bit pairs, which are widened to the index type of the loader */
+        template<typename P, typename Q>
+        static void takePairs(std::vector<P>& source, std::vector<Q>& target) {
+            target.assign(source.begin(), source.end());
+        }
+
+        void loadCsr() {
+            std::ifstream file;
+            file.open(path, std::ios_base::in | std::ios_base::binary);
+
+            if (!file.is_open()) {
+                error = "Failed to open file";
+                throw std::runtime_error(error);
+            }
+
+            char magic[8];
+            uint64_t header[3];
+
+            file.read(magic, sizeof(magic));
+            file.read((char*) header, sizeof(header));
+
+            if (!file || std::string(magic, sizeof(magic)) != MatrixWriter::csrMagic()) {
+                error = "Invalid binary csr file";
+                throw std::runtime_error(error);
+            }
+
+            nrows = header[0];
+            ncols = header[1];
+            nvalsInFile = header[2];
+
+            std::vector<uint64_t> offsets(nrows + 1);
+            std::vector<uint32_t> cols(nvalsInFile);
+
+            file.read((char*) offsets.data(), (std::streamsize) (sizeof(uint64_t) * offsets.size()));
+            file.read((char*) cols.data(), (std::streamsize) (sizeof(uint32_t) * cols.size()));
+
+            if (!file || offsets[nrows] != nvalsInFile) {
+                error = "Truncated binary csr file";
+                throw std::runtime_error(error);
+            }
+
+            fromCsr(offsets, cols);
+        }
+
+        void loadCsrz() {
+            std::ifstream file;
+            file.open(path, std::ios_base::in | std::ios_base::binary);
+
+            if (!file.is_open()) {
+                error = "Failed to open file";
+                throw std::runtime_error(error);
+            }
+
+            char magic[8];
+            CompressedCsr csrz;
+
+            file.read(magic, sizeof(magic));
+
+            if (!file || std::string(magic, sizeof(magic)) != MatrixWriter::csrzMagic() || !csrz.read(file)) {
+                error = "Invalid compressed csr file";
+                throw std::runtime_error(error);
+            }
+
+            nrows = csrz.getNrows();
+            ncols = csrz.getNcols();
+            nvalsInFile = csrz.getNvals();
+
+            std::vector<uint64_t> offsets;
+            std::vector<uint32_t> cols;
+            csrz.decode(offsets, cols);
+
+            fromCsr(offsets, cols);
+        }
+
+        /** Expands csr with sorted rows into pairs, symmetrized if graph is undirected */
+        void fromCsr(const std::vector<uint64_t>& offsets, const std::vector<uint32_t>& cols) {
+            pairs.reserve(isUndirected? nvalsInFile * 2: nvalsInFile);
+
+            for (size_t i = 0; i < nrows; i++) {
+                for (auto k = offsets[i]; k < offsets[i + 1]; k++) {
+                    assert(cols[k] < ncols);
+                    pairs.emplace_back((Index) i, (Index) cols[k]);
+                }
+            }
+
+            if (isUndirected) {
+                assert(nrows == ncols);
+
+                for (size_t k = 0; k < nvalsInFile; k++) {
+                    pairs.emplace_back(pairs[k].second, pairs[k].first);
+                }
+
+                details::sortUnique(pairs, nrows);
+            }
+
+            nvals = pairs.size();
+        }
 
         bool loaded = false;
         bool isUndirected;
@@ -205,11 +395,19 @@ namespace benchmark {
         std::vector<pair> pairs;
     };
 
-    class MatrixLoader2 {
+    using MatrixLoader = MatrixLoaderT<unsigned int>;
+    using MatrixLoader64 = MatrixLoaderT<uint64_t>;
+
+    /**
+     * Loader of the precomputed A^2 file of R = A + A^2 benchmarks: path of the source file with "2" appended.
+     * Generator specs have no such file (appended "2" would give another valid spec), so they are rejected.
+     */
+    template<typename Index>
+    class MatrixLoader2T {
     public:
 
-        explicit MatrixLoader2(const std::string& path)
-        : path(path + "2"), loader(this->path, false) {
+        explicit MatrixLoader2T(const std::string& path)
+        : path(squarePath(path)), loader(this->path, false) {
 
         }
 
@@ -223,15 +421,24 @@ namespace benchmark {
         }
 
         /** @return Converted read data to basic coo matrix */
-        Matrix getMatrix() const {
+        MatrixT<Index> getMatrix() const {
             return loader.getMatrix();
         }
 
     private:
+        static std::string squarePath(const std::string& path) {
+            if (MatrixGenerator::isSpec(path))
+                throw std::runtime_error("No precomputed A^2 file for generator spec: " + path);
+
+            return path + "2";
+        }
+
         std::string path;
-        MatrixLoader loader;
+        MatrixLoaderT<Index> loader;
     };
 
+    using MatrixLoader2 = MatrixLoader2T<unsigned int>;
+
 }
 
 #endif //SPBENCH_MATRIX_LOADER_HPP
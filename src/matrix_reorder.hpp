@@ -0,0 +1,396 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_MATRIX_REORDER_HPP
+#define SPBENCH_MATRIX_REORDER_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+#include <cstddef>
+#include <matrix.hpp>
+#include <matrix_generator.hpp>
+
+namespace benchmark {
+
+    namespace details {
+
+        /** Symmetrized pattern of A + A^T without self loops, rows sorted */
+        struct ReorderGraph {
+            size_t n = 0;
+            std::vector<size_t> offsets;
+            std::vector<unsigned int> adjacent;
+
+            size_t degree(size_t v) const {
+                return offsets[v + 1] - offsets[v];
+            }
+        };
+
+        inline ReorderGraph reorderGraph(const Matrix& m) {
+            assert(m.nrows == m.ncols);
+
+            ReorderGraph g;
+            g.n = m.nrows;
+
+            std::vector<size_t> counts(g.n + 1, 0);
+
+#pragma omp parallel for
+            for (long long k = 0; k < (long long) m.nvals; k++) {
+                auto i = m.rows[k];
+                auto j = m.cols[k];
+
+                if (i != j) {
+#pragma omp atomic
+                    counts[i + 1] += 1;
+#pragma omp atomic
+                    counts[j + 1] += 1;
+                }
+            }
+
+            for (size_t v = 0; v < g.n; v++) {
+                counts[v + 1] += counts[v];
+            }
+
+            std::vector<unsigned int> adjacent(counts[g.n]);
+            std::vector<size_t> fill(counts.begin(), counts.end() - 1);
+
+#pragma omp parallel for
+            for (long long k = 0; k < (long long) m.nvals; k++) {
+                auto i = m.rows[k];
+                auto j = m.cols[k];
+                size_t pi, pj;
+
+                if (i != j) {
+#pragma omp atomic capture
+                    pi = fill[i]++;
+#pragma omp atomic capture
+                    pj = fill[j]++;
+
+                    adjacent[pi] = j;
+                    adjacent[pj] = i;
+                }
+            }
+
+            // Both (i, j) and (j, i) may be stored, so rows are deduplicated
+            g.offsets.assign(g.n + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long v = 0; v < (long long) g.n; v++) {
+                auto first = adjacent.begin() + counts[v];
+                auto last = adjacent.begin() + counts[v + 1];
+                std::sort(first, last);
+                g.offsets[v + 1] = std::unique(first, last) - first;
+            }
+
+            for (size_t v = 0; v < g.n; v++) {
+                g.offsets[v + 1] += g.offsets[v];
+            }
+
+            g.adjacent.resize(g.offsets[g.n]);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (long long v = 0; v < (long long) g.n; v++) {
+                std::copy(adjacent.begin() + counts[v], adjacent.begin() + counts[v] + g.degree(v), g.adjacent.begin() + g.offsets[v]);
+            }
+
+            return g;
+        }
+
+    }
+
+    /**
+     * Vertex reordering applied between MatrixLoader and backend setup.
+     * The same permutation P is applied to rows and columns, A' = P A P^T, so A'^2 = P A^2 P^T.
+     *
+     * Orderings:
+     *  - none: file order;
+     *  - rcm: reverse Cuthill-McKee over A + A^T, each component starts from a pseudo-peripheral vertex;
+     *  - degree: descending degree of A + A^T;
+     *  - hub: hub clustering, vertices with degree above the average go first, relative order is kept;
+     *  - community: vertices grouped by label propagation communities (Rabbit order like locality).
+     */
+    class MatrixReorder {
+    public:
+
+        static const size_t COMMUNITY_ITERATIONS = 10;
+
+        explicit MatrixReorder(std::string ordering = "none")
+                : ordering(std::move(ordering)) {
+            assert(isKnown(this->ordering));
+        }
+
+        static bool isKnown(const std::string& ordering) {
+            return ordering == "none" || ordering == "rcm" || ordering == "degree" || ordering == "hub" || ordering == "community";
+        }
+
+        bool isEnabled() const {
+            return ordering != "none";
+        }
+
+        const std::string& getOrdering() const {
+            return ordering;
+        }
+
+        /** @return Suffix of the operation in reference keys, since relabeled input gives relabeled result */
+        std::string getKeySuffix() const {
+            return isEnabled()? "-" + ordering: "";
+        }
+
+        /** Computes permutation for the matrix and relabels it, time of both is reported by getElapsedTimeMs */
+        void reorder(Matrix& m) {
+            auto start = std::chrono::steady_clock::now();
+
+            auto g = details::reorderGraph(m);
+            std::vector<unsigned int> order;
+
+            if (ordering == "rcm")
+                order = orderRcm(g);
+            else if (ordering == "degree")
+                order = orderDegree(g);
+            else if (ordering == "hub")
+                order = orderHub(g);
+            else if (ordering == "community")
+                order = orderCommunity(g);
+            else {
+                order.resize(g.n);
+                for (size_t v = 0; v < g.n; v++) {
+                    order[v] = (unsigned int) v;
+                }
+            }
+
+            permutation.resize(g.n);
+
+#pragma omp parallel for
+            for (long long k = 0; k < (long long) g.n; k++) {
+                permutation[order[k]] = (unsigned int) k;
+            }
+
+            permute(m);
+
+            auto end = std::chrono::steady_clock::now();
+            elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        /** Relabels matrix with permutation of the last reorder call, for instance precomputed A^2 */
+        void permute(Matrix& m) const {
+            assert(m.nrows == permutation.size());
+            assert(m.ncols == permutation.size());
+
+            std::vector<details::GenPair> pairs(m.nvals);
+
+#pragma omp parallel for
+            for (long long k = 0; k < (long long) m.nvals; k++) {
+                pairs[k] = details::GenPair(permutation[m.rows[k]], permutation[m.cols[k]]);
+            }
+
+            details::sortUnique(pairs, m.nrows);
+
+#pragma omp parallel for
+            for (long long k = 0; k < (long long) pairs.size(); k++) {
+                m.rows[k] = pairs[k].first;
+                m.cols[k] = pairs[k].second;
+            }
+        }
+
+        double getElapsedTimeMs() const {
+            return elapsedMs;
+        }
+
+    private:
+
+        static std::vector<unsigned int> orderRcm(const details::ReorderGraph& g) {
+            std::vector<unsigned int> byDegree = orderByDegree(g, true);
+            std::vector<unsigned int> order;
+            std::vector<char> visited(g.n, 0);
+            std::vector<size_t> level(g.n, (size_t) -1);
+            std::vector<unsigned int> next;
+
+            order.reserve(g.n);
+
+            for (auto seed: byDegree) {
+                if (visited[seed])
+                    continue;
+
+                // One sweep to pseudo-peripheral vertex: min degree vertex of the last bfs level
+                std::vector<unsigned int> component(1, seed);
+                level[seed] = 0;
+                for (size_t k = 0; k < component.size(); k++) {
+                    auto v = component[k];
+                    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+                        auto u = g.adjacent[e];
+                        if (level[u] == (size_t) -1) {
+                            level[u] = level[v] + 1;
+                            component.push_back(u);
+                        }
+                    }
+                }
+
+                auto last = level[component.back()];
+                auto start = component.back();
+                for (auto v: component) {
+                    if (level[v] == last && g.degree(v) < g.degree(start))
+                        start = v;
+                }
+
+                // Cuthill-McKee: bfs, neighbours are visited by ascending degree
+                size_t first = order.size();
+                order.push_back(start);
+                visited[start] = 1;
+
+                for (size_t k = first; k < order.size(); k++) {
+                    auto v = order[k];
+                    next.clear();
+
+                    for (auto e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+                        auto u = g.adjacent[e];
+                        if (!visited[u]) {
+                            visited[u] = 1;
+                            next.push_back(u);
+                        }
+                    }
+
+                    std::sort(next.begin(), next.end(), [&](unsigned int a, unsigned int b) {
+                        return g.degree(a) < g.degree(b) || (g.degree(a) == g.degree(b) && a < b);
+                    });
+
+                    order.insert(order.end(), next.begin(), next.end());
+                }
+            }
+
+            std::reverse(order.begin(), order.end());
+            return order;
+        }
+
+        static std::vector<unsigned int> orderByDegree(const details::ReorderGraph& g, bool ascending) {
+            std::vector<unsigned int> order(g.n);
+            for (size_t v = 0; v < g.n; v++) {
+                order[v] = (unsigned int) v;
+            }
+
+            std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+                return ascending? g.degree(a) < g.degree(b): g.degree(a) > g.degree(b);
+            });
+
+            return order;
+        }
+
+        static std::vector<unsigned int> orderDegree(const details::ReorderGraph& g) {
+            return orderByDegree(g, false);
+        }
+
+        static std::vector<unsigned int> orderHub(const details::ReorderGraph& g) {
+            double average = g.n > 0? (double) g.adjacent.size() / (double) g.n: 0.0;
+            std::vector<unsigned int> order;
+            order.reserve(g.n);
+
+            for (size_t v = 0; v < g.n; v++) {
+                if ((double) g.degree(v) > average)
+                    order.push_back((unsigned int) v);
+            }
+            for (size_t v = 0; v < g.n; v++) {
+                if ((double) g.degree(v) <= average)
+                    order.push_back((unsigned int) v);
+            }
+
+            return order;
+        }
+
+        static std::vector<unsigned int> orderCommunity(const details::ReorderGraph& g) {
+            std::vector<unsigned int> labels(g.n);
+            std::vector<unsigned int> updated(g.n);
+
+            for (size_t v = 0; v < g.n; v++) {
+                labels[v] = (unsigned int) v;
+            }
+
+            // Synchronous label propagation: most frequent label among neighbours and itself,
+            // ties take the smallest label, so the result is deterministic for any threads count.
+            // Synchronous updates may still oscillate (e.g. labels swapping across bipartite edges),
+            // so iterations are capped by COMMUNITY_ITERATIONS and labels of the last one are used
+            for (size_t iteration = 0; iteration < COMMUNITY_ITERATIONS; iteration++) {
+                size_t changed = 0;
+
+#pragma omp parallel reduction(+: changed)
+                {
+                    std::vector<unsigned int> votes;
+
+#pragma omp for schedule(dynamic, 1024)
+                    for (long long v = 0; v < (long long) g.n; v++) {
+                        votes.clear();
+                        votes.push_back(labels[v]);
+                        for (auto e = g.offsets[v]; e < g.offsets[v + 1]; e++) {
+                            votes.push_back(labels[g.adjacent[e]]);
+                        }
+
+                        std::sort(votes.begin(), votes.end());
+
+                        auto best = labels[v];
+                        size_t bestCount = 0;
+
+                        for (size_t k = 0; k < votes.size();) {
+                            size_t l = k;
+                            while (l < votes.size() && votes[l] == votes[k]) l++;
+
+                            if (l - k > bestCount) {
+                                best = votes[k];
+                                bestCount = l - k;
+                            }
+
+                            k = l;
+                        }
+
+                        updated[v] = best;
+                        changed += best != labels[v]? 1: 0;
+                    }
+                }
+
+                labels.swap(updated);
+
+                if (changed == 0)
+                    break;
+            }
+
+            std::vector<unsigned int> order(g.n);
+            for (size_t v = 0; v < g.n; v++) {
+                order[v] = (unsigned int) v;
+            }
+
+            std::stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+                return labels[a] < labels[b];
+            });
+
+            return order;
+        }
+
+    private:
+        std::string ordering;
+        std::vector<unsigned int> permutation;
+        double elapsedMs = 0.0;
+    };
+
+}
+
+#endif //SPBENCH_MATRIX_REORDER_HPP
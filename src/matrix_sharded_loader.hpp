@@ -0,0 +1,452 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_MATRIX_SHARDED_LOADER_HPP
+#define SPBENCH_MATRIX_SHARDED_LOADER_HPP
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <matrix.hpp>
+
+namespace benchmark {
+    namespace details {
+
+        /** Read-only private mapping of the whole file, unmapped on destruction */
+        class MappedFile {
+        public:
+            explicit MappedFile(const std::string& path) {
+                int fd = ::open(path.c_str(), O_RDONLY);
+                if (fd < 0)
+                    throw std::runtime_error("Failed to open file");
+
+                struct stat st{};
+                if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+                    ::close(fd);
+                    throw std::runtime_error("Failed to stat file or file is empty");
+                }
+
+                size = (size_t) st.st_size;
+                void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+
+                if (mapped == MAP_FAILED)
+                    throw std::runtime_error("Failed to map file");
+
+                data = (const char*) mapped;
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile() {
+                ::munmap((void*) data, size);
+            }
+
+            /**
+             * Drops pages of [first, last) from the mapping, pages stay in page cache.
+             * Chunk is parsed once per pass, so resident set keeps only the chunks in flight.
+             */
+            void release(const char* first, const char* last) const {
+                const size_t page = (size_t) ::sysconf(_SC_PAGESIZE);
+                size_t begin = ((size_t) (first - data) + page - 1) / page * page;
+                size_t end = (size_t) (last - data) / page * page;
+
+                if (begin < end)
+                    ::madvise((void*) (data + begin), end - begin, MADV_DONTNEED);
+            }
+
+            const char* data = nullptr;
+            size_t size = 0;
+        };
+
+        inline const char* skipLine(const char* p, const char* end) {
+            while (p < end && *p != '\n')
+                p++;
+            return p < end ? p + 1 : end;
+        }
+
+        inline const char* skipBlanks(const char* p, const char* end) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+                p++;
+            return p;
+        }
+
+        /** Parses unsigned decimal at p, @return Position after the number or nullptr if there is no digit */
+        inline const char* parseUint(const char* p, const char* end, uint64_t& value) {
+            p = skipBlanks(p, end);
+
+            if (p == end || *p < '0' || *p > '9')
+                return nullptr;
+
+            value = 0;
+            while (p < end && *p >= '0' && *p <= '9')
+                value = value * 10 + (uint64_t) (*p++ - '0');
+
+            return p;
+        }
+
+        /**
+         * Calls f(row, col) with 1-based indices for each entry line in [first, last), values (if any) are ignored.
+         * @return False if some line is malformed
+         */
+        template<typename F>
+        inline bool scanEntries(const char* first, const char* last, F&& f) {
+            const char* p = first;
+
+            while (p < last) {
+                p = skipBlanks(p, last);
+
+                if (p == last)
+                    break;
+
+                if (*p == '\n' || *p == '%') {
+                    p = skipLine(p, last);
+                    continue;
+                }
+
+                uint64_t row, col;
+                p = parseUint(p, last, row);
+                if (p != nullptr)
+                    p = parseUint(p, last, col);
+                if (p == nullptr)
+                    return false;
+
+                f(row, col);
+                p = skipLine(p, last);
+            }
+
+            return true;
+        }
+
+    }
+
+    /**
+     * Two-pass loader of large Matrix Market files straight into csr, rows are split into shards of equal ranges.
+     *
+     * File is mapped and its entries are split into chunks at line boundaries, chunks are parsed in parallel.
+     * Pass one counts entries of each row, offsets are scanned per shard, so each shard gets exact-size slice
+     * of the columns storage. Pass two scatters columns into the slices, then rows are sorted and deduplicated
+     * in place within each shard. Unlike MatrixLoader, no intermediate coo pairs are kept and shards are never
+     * concatenated, so peak memory is the final csr plus the chunks of the file in flight.
+     *
+     * @tparam Index Type of column indices (see MatrixT)
+     */
+    template<typename Index>
+    class ShardedLoaderT {
+    public:
+
+        /** Chunk of the file text, parsed by one thread at once */
+        static const size_t CHUNK_SIZE = 1 << 22;
+
+        /** Expected entries per shard, shards are of equal row ranges */
+        static const size_t SHARD_ENTRIES = 1 << 20;
+
+        /**
+         * @param path Path to the Matrix Market file
+         * @param isUndirected True if graph in the matrix is undirected, and edges must be duplicated
+         */
+        explicit ShardedLoaderT(std::string path, bool isUndirected = false)
+                : path(std::move(path)), isUndirected(isUndirected) {
+
+        }
+
+        /** Attempts to load data, throws std::runtime_error if the file is malformed */
+        void loadData() {
+            assert(!loaded);
+
+            details::MappedFile file(path);
+            const char* end = file.data + file.size;
+            const char* p = file.data;
+
+            while (p < end && (*p == '%' || *p == '\n' || *p == '\r'))
+                p = details::skipLine(p, end);
+
+            uint64_t header[3];
+            for (auto& h: header) {
+                if (p == nullptr || (p = details::parseUint(p, end, h)) == nullptr)
+                    throw std::runtime_error("Invalid Matrix Market size line: " + path);
+            }
+
+            nrows = header[0];
+            ncols = header[1];
+            nvalsInFile = header[2];
+
+            if (isUndirected && nrows != ncols)
+                throw std::runtime_error("Undirected graph matrix must be square: " + path);
+
+            MatrixShape shape;
+            shape.nrows = nrows;
+            shape.ncols = ncols;
+
+            if (shape.indexBits() > 8 * sizeof(Index))
+                throw std::runtime_error("Matrix shape does not fit index type: " + path);
+
+            const char* body = details::skipLine(p, end);
+            auto bounds = chunkBounds(file, body, end);
+            size_t nchunks = bounds.size() - 1;
+
+            makeShards();
+            offsets.assign(nrows + 1, 0);
+
+            // Pass one: count entries of row i into offsets[i + 1]
+            size_t counted = 0;
+            bool valid = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+:counted) reduction(&&:valid)
+            for (long long c = 0; c < (long long) nchunks; c++) {
+                valid = details::scanEntries(bounds[c], bounds[c + 1], [&](uint64_t row, uint64_t col) {
+                    if (row == 0 || col == 0 || row > nrows || col > ncols) {
+                        valid = false;
+                        return;
+                    }
+
+                    counted += 1;
+                    count(row - 1);
+
+                    if (isUndirected && row != col)
+                        count(col - 1);
+                }) && valid;
+
+                file.release(bounds[c], bounds[c + 1]);
+            }
+
+            if (!valid)
+                throw std::runtime_error("Invalid Matrix Market entry: " + path);
+            if (counted != nvalsInFile)
+                throw std::runtime_error("Number of entries differs from the size line: " + path);
+
+            // Exclusive scan: offsets[i + 1] becomes start of row i and is used as its scatter cursor
+            size_t nshards = shardRows.size() - 1;
+            std::vector<size_t> shardStarts(nshards + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long s = 0; s < (long long) nshards; s++) {
+                size_t sum = 0;
+                for (size_t i = shardRows[s]; i < shardRows[s + 1]; i++) {
+                    size_t rowCount = offsets[i + 1];
+                    offsets[i + 1] = sum;
+                    sum += rowCount;
+                }
+                shardStarts[s + 1] = sum;
+            }
+
+            for (size_t s = 0; s < nshards; s++)
+                shardStarts[s + 1] += shardStarts[s];
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long s = 0; s < (long long) nshards; s++) {
+                for (size_t i = shardRows[s]; i < shardRows[s + 1]; i++)
+                    offsets[i + 1] += shardStarts[s];
+            }
+
+            cols.resize(shardStarts[nshards]);
+
+            // Pass two: scatter columns, cursors move from row starts to row ends, so offsets become csr offsets
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long c = 0; c < (long long) nchunks; c++) {
+                details::scanEntries(bounds[c], bounds[c + 1], [&](uint64_t row, uint64_t col) {
+                    place(row - 1, col - 1);
+
+                    if (isUndirected && row != col)
+                        place(col - 1, row - 1);
+                });
+
+                file.release(bounds[c], bounds[c + 1]);
+            }
+
+            std::vector<size_t> shardEnds(nshards);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long s = 0; s < (long long) nshards; s++) {
+                shardEnds[s] = sortUnique(shardRows[s], shardRows[s + 1], shardStarts[s]);
+            }
+
+            closeGaps(shardStarts, shardEnds);
+            nvals = cols.size();
+            loaded = true;
+        }
+
+        bool isLoaded() const {
+            return loaded;
+        }
+
+        size_t getNrows() const {
+            return nrows;
+        }
+
+        size_t getNcols() const {
+            return ncols;
+        }
+
+        size_t getNvals() const {
+            return nvals;
+        }
+
+        /** @return Number of row-range shards, which were loaded in parallel */
+        size_t getShardsCount() const {
+            return shardRows.size() - 1;
+        }
+
+        const std::vector<size_t>& getOffsets() const {
+            return offsets;
+        }
+
+        const std::vector<Index>& getCols() const {
+            return cols;
+        }
+
+        /** Moves loaded csr out of the loader without copy */
+        void takeCsr(std::vector<size_t>& rowOffsets, std::vector<Index>& colIndices) {
+            assert(loaded);
+
+            rowOffsets.swap(offsets);
+            colIndices.swap(cols);
+            std::vector<size_t>().swap(offsets);
+            std::vector<Index>().swap(cols);
+        }
+
+    private:
+
+        /**
+         * Splits [first, last) into chunks of about CHUNK_SIZE bytes, each chunk starts at a line start.
+         * Page cache may map large folios around each boundary, so pages are dropped as soon as boundary is found.
+         */
+        static std::vector<const char*> chunkBounds(const details::MappedFile& file, const char* first, const char* last) {
+            std::vector<const char*> bounds(1, first);
+
+            while (bounds.back() < last) {
+                const char* p = bounds.back() + std::min((size_t) CHUNK_SIZE, (size_t) (last - bounds.back()));
+
+                while (p < last && p[-1] != '\n')
+                    p++;
+
+                file.release(bounds.back(), p);
+                bounds.push_back(p);
+            }
+
+            if (bounds.size() == 1)
+                bounds.push_back(last);
+
+            return bounds;
+        }
+
+        void makeShards() {
+            size_t entries = isUndirected ? 2 * nvalsInFile : nvalsInFile;
+            size_t nshards = std::max<size_t>(1, std::min<size_t>(nrows, entries / SHARD_ENTRIES));
+            size_t rowsPerShard = std::max<size_t>(1, (nrows + nshards - 1) / nshards);
+
+            shardRows.assign(1, 0);
+
+            for (size_t first = 0; first < nrows; first += rowsPerShard)
+                shardRows.push_back(std::min(nrows, first + rowsPerShard));
+        }
+
+        void count(uint64_t row) {
+            auto& counter = offsets[row + 1];
+
+#pragma omp atomic
+            counter += 1;
+        }
+
+        void place(uint64_t row, uint64_t col) {
+            auto& cursor = offsets[row + 1];
+            size_t pos;
+
+#pragma omp atomic capture
+            pos = cursor++;
+
+            cols[pos] = (Index) col;
+        }
+
+        /**
+         * Sorts rows [firstRow, lastRow) and removes duplicates with in place compaction within the shard slice.
+         * Offsets of the rows are updated, offsets[firstRow] belongs to the previous shard and is not touched.
+         * @return End of the compacted slice
+         */
+        size_t sortUnique(size_t firstRow, size_t lastRow, size_t start) {
+            size_t begin = start;
+            size_t pos = start;
+
+            for (size_t i = firstRow; i < lastRow; i++) {
+                auto first = cols.begin() + begin;
+                auto last = cols.begin() + offsets[i + 1];
+
+                std::sort(first, last);
+                auto unique = std::unique(first, last);
+
+                begin = offsets[i + 1];
+                pos = std::copy(first, unique, cols.begin() + pos) - cols.begin();
+                offsets[i + 1] = pos;
+            }
+
+            return pos;
+        }
+
+        /** Moves compacted shard slices to close the gaps left by removed duplicates, storage is not reallocated */
+        void closeGaps(const std::vector<size_t>& shardStarts, const std::vector<size_t>& shardEnds) {
+            size_t pos = 0;
+
+            for (size_t s = 0; s < shardEnds.size(); s++) {
+                size_t shift = shardStarts[s] - pos;
+
+                if (shift > 0) {
+                    std::copy(cols.begin() + shardStarts[s], cols.begin() + shardEnds[s], cols.begin() + pos);
+
+                    for (size_t i = shardRows[s]; i < shardRows[s + 1]; i++)
+                        offsets[i + 1] -= shift;
+                }
+
+                pos += shardEnds[s] - shardStarts[s];
+            }
+
+            cols.resize(pos);
+        }
+
+        bool loaded = false;
+        std::string path;
+        bool isUndirected;
+        size_t nrows = 0;
+        size_t ncols = 0;
+        size_t nvals = 0;
+        size_t nvalsInFile = 0;
+        std::vector<size_t> shardRows;
+        std::vector<size_t> offsets;
+        std::vector<Index> cols;
+    };
+
+    using ShardedLoader = ShardedLoaderT<unsigned int>;
+    using ShardedLoader64 = ShardedLoaderT<uint64_t>;
+
+}
+
+#endif //SPBENCH_MATRIX_SHARDED_LOADER_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_MATRIX_UTILS_HPP
+#define SPBENCH_MATRIX_UTILS_HPP
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <matrix.hpp>
+
+namespace benchmark {
+
+    /**
+     * Strong 64-bit mix of the entry (row, col) (splitmix64 finalizer).
+     * Sum of entry hashes modulo 2^64 is an order independent hash of the matrix pattern.
+     */
+    inline uint64_t entryHash(uint64_t row, uint64_t col) {
+        uint64_t z = (row << 32 | col) + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    /** Order independent fingerprint of the matrix pattern: number of entries and sum of their entryHash modulo 2^64 */
+    struct Fingerprint {
+        size_t nvals = 0;
+        uint64_t hash = 0;
+
+        void add(uint64_t row, uint64_t col) {
+            nvals += 1;
+            hash += entryHash(row, col);
+        }
+
+        void merge(const Fingerprint& other) {
+            nvals += other.nvals;
+            hash += other.hash;
+        }
+
+        /** @return Fingerprint as "nvals:hash" with hexadecimal hash */
+        std::string toString() const {
+            static const char digits[] = "0123456789abcdef";
+            std::string hex(16, '0');
+
+            for (size_t i = 0; i < 16; i++) {
+                hex[15 - i] = digits[(hash >> (4 * i)) & 0xf];
+            }
+
+            return std::to_string(nvals) + ":" + hex;
+        }
+    };
+
+    /**
+     * Fingerprint of the csr pattern in place, offsets and cols may be of any integral types (host copies of backend buffers).
+     * @param nrows Number of rows, offsets has nrows + 1 entries
+     */
+    template<typename Offset, typename Index>
+    inline Fingerprint fingerprintCsr(size_t nrows, const Offset* offsets, const Index* cols) {
+        uint64_t hash = 0;
+
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:hash)
+        for (long long i = 0; i < (long long) nrows; i++) {
+            for (auto k = offsets[i]; k < offsets[i + 1]; k++) {
+                hash += entryHash((uint64_t) i, (uint64_t) cols[k]);
+            }
+        }
+
+        Fingerprint fingerprint;
+        fingerprint.nvals = nrows > 0? (size_t) (offsets[nrows] - offsets[0]): 0;
+        fingerprint.hash = hash;
+        return fingerprint;
+    }
+
+    /**
+     * Fingerprint of the doubly compressed csr pattern: only nzr non-empty rows are stored.
+     * @param rowIndices Indices of non-empty rows, nzr entries
+     * @param offsets Offsets of non-empty rows, nzr + 1 entries
+     */
+    template<typename Offset, typename Index>
+    inline Fingerprint fingerprintDcsr(size_t nzr, const Index* rowIndices, const Offset* offsets, const Index* cols) {
+        uint64_t hash = 0;
+
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:hash)
+        for (long long r = 0; r < (long long) nzr; r++) {
+            for (auto k = offsets[r]; k < offsets[r + 1]; k++) {
+                hash += entryHash((uint64_t) rowIndices[r], (uint64_t) cols[k]);
+            }
+        }
+
+        Fingerprint fingerprint;
+        fingerprint.nvals = nzr > 0? (size_t) (offsets[nzr] - offsets[0]): 0;
+        fingerprint.hash = hash;
+        return fingerprint;
+    }
+
+    /** Fingerprint of the coo pattern, entries may go in any order, but must be unique */
+    template<typename Index>
+    inline Fingerprint fingerprintCoo(size_t nvals, const Index* rows, const Index* cols) {
+        uint64_t hash = 0;
+
+#pragma omp parallel for reduction(+:hash)
+        for (long long k = 0; k < (long long) nvals; k++) {
+            hash += entryHash((uint64_t) rows[k], (uint64_t) cols[k]);
+        }
+
+        Fingerprint fingerprint;
+        fingerprint.nvals = nvals;
+        fingerprint.hash = hash;
+        return fingerprint;
+    }
+
+    /**
+     * Strictly lower triangular part of the symmetrized matrix (graph is treated as undirected, loops are dropped).
+     * @return Matrix with entries sorted by (row, col)
+     */
+    inline Matrix lowerTriangle(const Matrix& m) {
+        using pair = std::pair<unsigned int, unsigned int>;
+
+        std::vector<pair> pairs;
+        pairs.reserve(m.nvals);
+
+        for (size_t i = 0; i < m.nvals; i++) {
+            auto r = m.rows[i];
+            auto c = m.cols[i];
+
+            if (r != c)
+                pairs.emplace_back(std::max(r, c), std::min(r, c));
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        Matrix l;
+        l.nrows = m.nrows;
+        l.ncols = m.ncols;
+        l.nvals = pairs.size();
+        l.rows.reserve(pairs.size());
+        l.cols.reserve(pairs.size());
+
+        for (auto& p: pairs) {
+            l.rows.push_back(p.first);
+            l.cols.push_back(p.second);
+        }
+
+        return l;
+    }
+
+    /**
+     * Deterministic pseudo-random traversal source, so all backends start from the same vertices.
+     * Source of the random edge is taken, therefore vertex has at least one out edge.
+     */
+    inline unsigned int traversalSource(const Matrix& m, size_t seed) {
+        assert(m.nvals > 0);
+
+        std::mt19937_64 engine(seed);
+        return m.rows[engine() % m.nvals];
+    }
+
+    /**
+     * Deterministic split of matrix entries into base matrix and stream of insertion batches.
+     * Batches take pseudo-random entries, base keeps the rest in input order.
+     */
+    inline void splitStream(const Matrix& m, size_t batchesCount, size_t batchSize, size_t seed,
+                            Matrix& base, std::vector<Matrix>& batches) {
+        std::vector<size_t> order(m.nvals);
+        for (size_t i = 0; i < m.nvals; i++)
+            order[i] = i;
+
+        std::mt19937_64 engine(seed);
+        std::shuffle(order.begin(), order.end(), engine);
+
+        size_t streamed = std::min(m.nvals, batchesCount * batchSize);
+        std::vector<bool> inStream(m.nvals, false);
+
+        batches.clear();
+
+        for (size_t first = 0; first < streamed; first += batchSize) {
+            Matrix batch;
+            batch.nrows = m.nrows;
+            batch.ncols = m.ncols;
+
+            for (size_t k = first; k < std::min(streamed, first + batchSize); k++) {
+                batch.rows.push_back(m.rows[order[k]]);
+                batch.cols.push_back(m.cols[order[k]]);
+                inStream[order[k]] = true;
+            }
+
+            batch.nvals = batch.rows.size();
+            batches.push_back(std::move(batch));
+        }
+
+        base = Matrix{};
+        base.nrows = m.nrows;
+        base.ncols = m.ncols;
+
+        for (size_t i = 0; i < m.nvals; i++) {
+            if (!inStream[i]) {
+                base.rows.push_back(m.rows[i]);
+                base.cols.push_back(m.cols[i]);
+            }
+        }
+
+        base.nvals = base.rows.size();
+    }
+
+    /**
+     * Signature of connected components labeling, which does not depend on labels values:
+     * each vertex is relabeled by the first vertex of its component, relabeling is hashed (FNV-1a).
+     * @return Components count and hash in form "count:hash"
+     */
+    template<typename T>
+    inline std::string componentsSignature(const std::vector<T>& labels) {
+        std::unordered_map<T, uint64_t> canonical;
+        uint64_t hash = 14695981039346656037ull;
+
+        for (size_t v = 0; v < labels.size(); v++) {
+            auto found = canonical.emplace(labels[v], (uint64_t) v).first;
+            hash = (hash ^ found->second) * 1099511628211ull;
+        }
+
+        return std::to_string(canonical.size()) + ":" + std::to_string(hash);
+    }
+
+    /**
+     * Deterministic pseudo-random matrix, each entry is set with given probability.
+     * @return Matrix with entries sorted by (row, col)
+     */
+    inline Matrix randomMatrix(size_t nrows, size_t ncols, double density, size_t seed) {
+        std::mt19937_64 engine(seed);
+        std::bernoulli_distribution entry(density);
+
+        Matrix m;
+        m.nrows = nrows;
+        m.ncols = ncols;
+
+        for (size_t i = 0; i < nrows; i++) {
+            for (size_t j = 0; j < ncols; j++) {
+                if (entry(engine)) {
+                    m.rows.push_back(i);
+                    m.cols.push_back(j);
+                }
+            }
+        }
+
+        m.nvals = m.rows.size();
+        return m;
+    }
+
+}
+
+#endif //SPBENCH_MATRIX_UTILS_HPP
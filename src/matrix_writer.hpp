@@ -32,56 +32,335 @@
 #include <sstream>
 #include <algorithm>
 #include <cassert>
-#include <unordered_set>
+#include <cstdint>
+#include <cerrno>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
 #include <matrix.hpp>
+#include <matrix_generator.hpp>
+#include <matrix_codec.hpp>
 
 namespace benchmark {
 
+    namespace details {
+
+        inline uint32_t digitsCount(uint64_t value) {
+            uint32_t digits = 1;
+
+            while (value >= 10000) {
+                value /= 10000;
+                digits += 4;
+            }
+
+            return digits + (value >= 10) + (value >= 100) + (value >= 1000);
+        }
+
+        /** Formats decimal value at p, two digits per step, @return Position after the last digit */
+        inline char* formatUint(char* p, uint64_t value) {
+            static const char pairs[] =
+                    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                    "8081828384858687888990919293949596979899";
+
+            uint32_t digits = digitsCount(value);
+            char* end = p + digits;
+            char* q = end;
+
+            while (value >= 100) {
+                auto i = (size_t) (value % 100) * 2;
+                value /= 100;
+                *(--q) = pairs[i + 1];
+                *(--q) = pairs[i];
+            }
+
+            if (value >= 10) {
+                auto i = (size_t) value * 2;
+                *(--q) = pairs[i + 1];
+                *(--q) = pairs[i];
+            }
+            else {
+                *(--q) = (char) ('0' + value);
+            }
+
+            return end;
+        }
+
+        /** pwrite of the whole range, partial writes and interrupts are retried */
+        inline bool writeAll(int fd, const char* data, size_t size, uint64_t offset) {
+            while (size > 0) {
+                auto written = ::pwrite(fd, data, size, (off_t) offset);
+
+                if (written < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    return false;
+                }
+
+                data += written;
+                size -= (size_t) written;
+                offset += (uint64_t) written;
+            }
+
+            return true;
+        }
+
+    }
+
     class MatrixWriter {
     public:
 
+        /** Bytes of per-thread text buffer of Matrix Market writer */
+        static const size_t TEXT_BUFFER_SIZE = 1 << 22;
+        /** Entries per chunk of Matrix Market writer, chunks are formatted in parallel */
+        static const size_t TEXT_CHUNK_SIZE = 1 << 20;
+
         /**
-         * Write matrix data into Matrix Market file format.
+         * Write matrix data into Matrix Market file format with `pattern` banner, entries go sorted by (row, col).
          * @param path Path to the file
+         * @param isSortedUnique True if entries are already sorted by (row, col) without duplicates,
+         *                       otherwise they are sorted and deduplicated first
          */
-        void save(const std::string& path, const Matrix& m) {
-            std::ofstream file;
-            file.open(path, std::ios_base::out);
+        template<typename Index>
+        void save(const std::string& path, const MatrixT<Index>& m, bool isSortedUnique = false) {
+            std::vector<uint64_t> offsets;
+            std::vector<Index> cols;
 
-            if (!file.is_open()) {
+            if (!isSortedUnique) {
+                toCsr(m, offsets, cols);
+                saveMtx(path, m.nrows, m.ncols, offsets.data(), cols.data());
+                return;
+            }
+
+            offsets.assign(m.nrows + 1, 0);
+
+            for (size_t i = 0; i < m.nvals; i++) {
+                assert(i == 0 || m.rows[i - 1] < m.rows[i] || (m.rows[i - 1] == m.rows[i] && m.cols[i - 1] < m.cols[i]));
+                offsets[m.rows[i] + 1] += 1;
+            }
+            for (size_t i = 0; i < m.nrows; i++) {
+                offsets[i + 1] += offsets[i];
+            }
+
+            saveMtx(path, m.nrows, m.ncols, offsets.data(), m.cols.data());
+        }
+
+        /**
+         * Write csr pattern into Matrix Market file format with `pattern` banner.
+         * Size of each chunk of entries in text is computed first, then chunks are formatted into
+         * per-thread buffers in parallel and written with pwrite at their offsets in the file.
+         * @param path Path to the file
+         * @param offsets Row offsets, nrows + 1 entries
+         * @param cols Column indices, entries are written in the csr order
+         */
+        template<typename Index>
+        void saveMtx(const std::string& path, size_t nrows, size_t ncols, const uint64_t* offsets, const Index* cols) {
+            int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+            if (fd < 0) {
                 error = "Failed to open file";
                 return;
             }
 
-            using pair = std::pair<unsigned int, unsigned int>;
+            uint64_t nvals = offsets[nrows] - offsets[0];
+
+            std::stringstream headerStream;
+            headerStream << "%%MatrixMarket matrix coordinate pattern general\n"
+                         << nrows << " " << ncols << " " << nvals << "\n";
+            std::string header = headerStream.str();
+
+            // Row ranges of chunks with about TEXT_CHUNK_SIZE entries
+            std::vector<size_t> bounds(1, 0);
+            size_t chunkSize = TEXT_CHUNK_SIZE;
 
-            struct Hash {
-                size_t operator()(const pair& p) const {
-                    return std::hash<unsigned int>()(p.first) + std::hash<unsigned int>()(p.second);
+            for (size_t i = 0; i < nrows; i++) {
+                if (offsets[i + 1] - offsets[bounds.back()] >= chunkSize)
+                    bounds.push_back(i + 1);
+            }
+            if (bounds.back() != nrows)
+                bounds.push_back(nrows);
+
+            size_t chunksCount = bounds.size() - 1;
+            std::vector<uint64_t> positions(chunksCount + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (long long k = 0; k < (long long) chunksCount; k++) {
+                uint64_t bytes = 0;
+
+                for (size_t i = bounds[k]; i < bounds[k + 1]; i++) {
+                    uint64_t rowBytes = details::digitsCount(i + 1) + 2;
+
+                    for (auto j = offsets[i]; j < offsets[i + 1]; j++) {
+                        bytes += rowBytes + details::digitsCount((uint64_t) cols[j] + 1);
+                    }
                 }
-            };
 
-            struct Eq {
-                size_t operator()(const pair& a, const pair& b) const {
-                    return a.first == b.first && a.second == b.second;
+                positions[k + 1] = bytes;
+            }
+
+            positions[0] = header.size();
+            for (size_t k = 0; k < chunksCount; k++) {
+                positions[k + 1] += positions[k];
+            }
+
+            std::atomic<bool> failed(!details::writeAll(fd, header.data(), header.size(), 0));
+
+#pragma omp parallel
+            {
+                std::vector<char> buffer(TEXT_BUFFER_SIZE);
+
+#pragma omp for schedule(dynamic, 1)
+                for (long long k = 0; k < (long long) chunksCount; k++) {
+                    uint64_t position = positions[k];
+                    size_t used = 0;
+
+                    for (size_t i = bounds[k]; i < bounds[k + 1]; i++) {
+                        for (auto j = offsets[i]; j < offsets[i + 1]; j++) {
+                            // Longest line is two 20 digits numbers, space and new line
+                            if (buffer.size() - used < 64) {
+                                if (!details::writeAll(fd, buffer.data(), used, position))
+                                    failed = true;
+
+                                position += used;
+                                used = 0;
+                            }
+
+                            char* p = buffer.data() + used;
+                            p = details::formatUint(p, i + 1);
+                            *(p++) = ' ';
+                            p = details::formatUint(p, (uint64_t) cols[j] + 1);
+                            *(p++) = '\n';
+                            used = (size_t) (p - buffer.data());
+                        }
+                    }
+
+                    if (!details::writeAll(fd, buffer.data(), used, position))
+                        failed = true;
+
+                    assert(failed || position + used == positions[k + 1]);
                 }
-            };
+            }
+
+            if (::close(fd) != 0 || failed) {
+                error = "Failed to write file";
+            }
+        }
 
-            std::unordered_set<pair, Hash, Eq> pairsSet;
+        /**
+         * Write matrix data into binary csr file format.
+         * Layout: 8 bytes magic `SPBCSR01`, uint64 nrows, ncols, nvals,
+         * uint64 row offsets[nrows + 1], uint32 column indices[nvals] sorted within rows without duplicates.
+         * @param path Path to the file
+         */
+        void saveCsr(const std::string& path, const Matrix& m) {
+            std::ofstream file;
+            file.open(path, std::ios_base::out | std::ios_base::binary);
+
+            if (!file.is_open()) {
+                error = "Failed to open file";
+                return;
+            }
+
+            std::vector<uint64_t> offsets;
+            std::vector<uint32_t> cols;
+            toCsr(m, offsets, cols);
+
+            uint64_t header[3] = { m.nrows, m.ncols, cols.size() };
+
+            file.write(csrMagic(), 8);
+            file.write((const char*) header, sizeof(header));
+            file.write((const char*) offsets.data(), (std::streamsize) (sizeof(uint64_t) * offsets.size()));
+            file.write((const char*) cols.data(), (std::streamsize) (sizeof(uint32_t) * cols.size()));
+
+            if (!file) {
+                error = "Failed to write file";
+            }
+
+            file.close();
+        }
+
+        /**
+         * Write matrix data into compressed binary csr file format.
+         * Layout: 8 bytes magic `SPBCSZ01` and serialized CompressedCsr (row sizes and column deltas streams).
+         * @param path Path to the file
+         */
+        void saveCsrz(const std::string& path, const Matrix& m) {
+            std::ofstream file;
+            file.open(path, std::ios_base::out | std::ios_base::binary);
 
-            for (auto i = 0; i < m.nvals; i++) {
-                pairsSet.emplace(m.rows[i], m.cols[i]);
+            if (!file.is_open()) {
+                error = "Failed to open file";
+                return;
             }
 
-            file << m.nrows << " " << m.ncols << " " << pairsSet.size() << std::endl;
+            std::vector<uint64_t> offsets;
+            std::vector<uint32_t> cols;
+            toCsr(m, offsets, cols);
+
+            CompressedCsr csrz;
+            csrz.encode(m.nrows, m.ncols, offsets.data(), cols.data());
+
+            file.write(csrzMagic(), 8);
 
-            for (auto& e: pairsSet) {
-                file << e.first + 1 << " " << e.second + 1 << std::endl;
+            if (!csrz.write(file)) {
+                error = "Failed to write file";
             }
 
             file.close();
         }
 
+        /** Converts coo into csr with sorted rows without duplicates */
+        template<typename Index>
+        static void toCsr(const MatrixT<Index>& m, std::vector<uint64_t>& offsets, std::vector<Index>& cols) {
+            std::vector<std::pair<Index, Index>> pairs;
+            pairs.reserve(m.nvals);
+
+            for (size_t i = 0; i < m.nvals; i++) {
+                pairs.emplace_back(m.rows[i], m.cols[i]);
+            }
+
+            details::sortUnique(pairs, m.nrows);
+
+            offsets.assign(m.nrows + 1, 0);
+            cols.resize(pairs.size());
+
+            for (size_t i = 0; i < pairs.size(); i++) {
+                offsets[pairs[i].first + 1] += 1;
+                cols[i] = pairs[i].second;
+            }
+            for (size_t i = 0; i < m.nrows; i++) {
+                offsets[i + 1] += offsets[i];
+            }
+        }
+
+        /** @return True if path has `.csr` extension of the binary csr format (`.csr2` for A^2 of MatrixLoader2) */
+        static bool isCsrFile(const std::string& path) {
+            return hasExtension(path, ".csr") || hasExtension(path, ".csr2");
+        }
+
+        /** @return True if path has `.csrz` extension of the compressed csr format (`.csrz2` for A^2 of MatrixLoader2) */
+        static bool isCsrzFile(const std::string& path) {
+            return hasExtension(path, ".csrz") || hasExtension(path, ".csrz2");
+        }
+
+        /** @return 8 bytes magic of the binary csr format */
+        static const char* csrMagic() {
+            return "SPBCSR01";
+        }
+
+        /** @return 8 bytes magic of the compressed csr format */
+        static const char* csrzMagic() {
+            return "SPBCSZ01";
+        }
+
+    private:
+
+        static bool hasExtension(const std::string& path, const std::string& extension) {
+            return path.size() > extension.size() &&
+                   path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+        }
+
     public:
 
         std::string error;
@@ -0,0 +1,186 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_bfs.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Bfs : public BenchmarkBase {
+    public:
+
+        Bfs(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // push: sparse frontier expanded along out edges
+            // pull: unvisited vertices look for parent in bitmap frontier
+            // auto: direction-optimizing switching between push and pull
+            direction = argsProcessor.getOption("direction", "auto");
+            assert(direction == "push" || direction == "pull" || direction == "auto");
+
+            // Fixed source vertex, by default each iteration takes its own pseudo-random source
+            source = argsProcessor.getOption("source", "random");
+
+            benchmarkName = "Native-Bfs-" + direction;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Bfs() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::MirroredMatrix(native::cooToCsr(input));
+            undirected = type;
+
+            // In edges of directed graph are required for pull steps, transpose is not measured
+            if (direction != "push" && !undirected)
+                A.csc();
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::MirroredMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            start = source == "random" ? traversalSource(input, iterationIdx) : (unsigned int) std::stoul(source);
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            auto dir = direction == "push" ? native::BfsDirection::Push :
+                       direction == "pull" ? native::BfsDirection::Pull :
+                       native::BfsDirection::Auto;
+            const auto& at = undirected || direction == "push" ? A.csr() : A.csc();
+
+            result = native::bfs(A.csr(), at, start, dir);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            const auto& a = A.csr();
+            double pushMs = 0.0;
+            double pullMs = 0.0;
+            int depth = 0;
+            size_t edges = 0;
+
+            for (size_t i = 0; i < result.trace.size(); i++) {
+                auto& level = result.trace[i];
+                (level.pull ? pullMs : pushMs) += level.ms;
+
+#ifdef BENCH_DEBUG
+                log << "   level " << i << ": frontier " << level.frontier << " edges " << level.edges
+                    << (level.pull ? " pull " : " push ") << level.ms << " ms" << std::endl;
+#endif
+            }
+
+            // Traversed edges are all out edges of the reached vertices
+            for (size_t v = 0; v < a.nrows; v++) {
+                if (result.levels[v] != -1) {
+                    edges += a.rowOffsets[v + 1] - a.rowOffsets[v];
+                    depth = std::max(depth, result.levels[v]);
+                }
+            }
+
+            double totalMs = pushMs + pullMs;
+
+            addStageSample("push", pushMs);
+            addStageSample("pull", pullMs);
+
+            addMetric("levels", (double) result.trace.size());
+            addMetric("reached", (double) result.reached);
+            addMetric("MTEPS", totalMs > 0.0 ? (double) edges / totalMs / 1e3 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result: source " << start << " reached " << result.reached << " depth " << depth
+                << " traversed edges " << edges << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":bfs-" + std::to_string(start),
+                             std::to_string(result.reached) + ":" + std::to_string(depth));
+
+            result = native::BfsResult{};
+        }
+
+    protected:
+
+        native::MirroredMatrix A;
+        native::BfsResult result;
+        bool undirected = false;
+        unsigned int start = 0;
+
+        std::string direction;
+        std::string source;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Bfs bfs(argc, argv);
+    bfs.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,355 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_BFS_HPP
+#define SPBENCH_NATIVE_BFS_HPP
+
+#include <native_csr.hpp>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <omp.h>
+
+namespace benchmark {
+    namespace native {
+
+        enum class BfsDirection {
+            Push,
+            Pull,
+            Auto
+        };
+
+        /** Statistics of the single bfs level */
+        struct BfsLevel {
+            size_t frontier = 0;
+            size_t edges = 0;
+            bool pull = false;
+            double ms = 0.0;
+        };
+
+        struct BfsResult {
+            std::vector<int> levels;
+            std::vector<BfsLevel> trace;
+            size_t reached = 0;
+        };
+
+        namespace details {
+
+            inline size_t frontierEdges(const CsrMatrix& a, const std::vector<unsigned int>& frontier) {
+                size_t edges = 0;
+
+#pragma omp parallel for reduction(+:edges)
+                for (size_t k = 0; k < frontier.size(); k++) {
+                    auto v = frontier[k];
+                    edges += a.rowOffsets[v + 1] - a.rowOffsets[v];
+                }
+
+                return edges;
+            }
+
+            /** Expands sparse frontier along out edges, vertices are claimed by compare-and-swap on level */
+            inline void bfsPush(const CsrMatrix& a, std::vector<int>& levels, int depth,
+                                const std::vector<unsigned int>& frontier, std::vector<unsigned int>& next) {
+                std::vector<std::vector<unsigned int>> local(omp_get_max_threads());
+                std::vector<size_t> offsets(local.size() + 1, 0);
+
+#pragma omp parallel
+                {
+                    auto& out = local[omp_get_thread_num()];
+
+#pragma omp for schedule(dynamic, 64)
+                    for (size_t k = 0; k < frontier.size(); k++) {
+                        auto u = frontier[k];
+
+                        for (size_t e = a.rowOffsets[u]; e < a.rowOffsets[u + 1]; e++) {
+                            auto v = a.colIndices[e];
+                            int expected = -1;
+
+                            if (__atomic_load_n(&levels[v], __ATOMIC_RELAXED) == -1 &&
+                                __atomic_compare_exchange_n(&levels[v], &expected, depth, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                                out.push_back(v);
+                        }
+                    }
+                }
+
+                for (size_t t = 0; t < local.size(); t++)
+                    offsets[t + 1] = offsets[t] + local[t].size();
+
+                next.resize(offsets.back());
+
+#pragma omp parallel for schedule(static, 1)
+                for (size_t t = 0; t < local.size(); t++)
+                    std::copy(local[t].begin(), local[t].end(), next.begin() + offsets[t]);
+            }
+
+            /** Each unvisited vertex scans its in edges until parent in the bitmap frontier is found */
+            inline size_t bfsPull(const CsrMatrix& at, std::vector<int>& levels, int depth,
+                                  const std::vector<uint8_t>& frontier, std::vector<uint8_t>& next) {
+                size_t found = 0;
+
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:found)
+                for (size_t v = 0; v < at.nrows; v++) {
+                    next[v] = 0;
+
+                    if (levels[v] != -1)
+                        continue;
+
+                    for (size_t e = at.rowOffsets[v]; e < at.rowOffsets[v + 1]; e++) {
+                        if (frontier[at.colIndices[e]]) {
+                            levels[v] = depth;
+                            next[v] = 1;
+                            found += 1;
+                            break;
+                        }
+                    }
+                }
+
+                return found;
+            }
+
+        }
+
+        /**
+         * Level-synchronous bfs from the source.
+         * Auto direction follows Beamer et al.: switch to pull if frontier edges exceed unexplored edges / alpha,
+         * switch back to push if frontier shrinks below n / beta.
+         *
+         * @param a Adjacency matrix, out edges are rows
+         * @param at Transposed adjacency matrix (same as a for undirected graph), used by pull steps
+         * @return Level of each vertex (-1 if not reached) and per-level trace
+         */
+        inline BfsResult bfs(const CsrMatrix& a, const CsrMatrix& at, unsigned int source, BfsDirection direction,
+                             double alpha = 14.0, double beta = 24.0) {
+            assert(a.nrows == a.ncols);
+            assert(direction == BfsDirection::Push || (at.nrows == a.nrows && at.ncols == a.ncols));
+            assert(source < a.nrows);
+
+            size_t n = a.nrows;
+
+            BfsResult result;
+            result.levels.assign(n, -1);
+            result.levels[source] = 0;
+            result.reached = 1;
+
+            std::vector<unsigned int> frontier{source};
+            std::vector<unsigned int> nextFrontier;
+            std::vector<uint8_t> bitmap;
+            std::vector<uint8_t> nextBitmap;
+
+            size_t frontierSize = 1;
+            size_t frontierEdges = details::frontierEdges(a, frontier);
+            size_t unexploredEdges = a.nvals() - frontierEdges;
+            bool pull = direction == BfsDirection::Pull;
+
+            for (int depth = 1; frontierSize > 0; depth++) {
+                auto start = std::chrono::steady_clock::now();
+
+                if (direction == BfsDirection::Auto) {
+                    if (!pull && (double) frontierEdges > (double) unexploredEdges / alpha)
+                        pull = true;
+                    else if (pull && (double) frontierSize < (double) n / beta)
+                        pull = false;
+                }
+
+                BfsLevel level;
+                level.frontier = frontierSize;
+                level.edges = frontierEdges;
+                level.pull = pull;
+
+                if (pull) {
+                    // Switch to the dense representation of the frontier
+                    if (bitmap.empty()) {
+                        bitmap.assign(n, 0);
+                        nextBitmap.assign(n, 0);
+
+#pragma omp parallel for
+                        for (size_t k = 0; k < frontier.size(); k++)
+                            bitmap[frontier[k]] = 1;
+
+                        frontier.clear();
+                    }
+
+                    frontierSize = details::bfsPull(at, result.levels, depth, bitmap, nextBitmap);
+                    std::swap(bitmap, nextBitmap);
+                }
+                else {
+                    // Switch back to the sparse representation of the frontier
+                    if (!bitmap.empty()) {
+                        frontier.clear();
+                        for (size_t v = 0; v < n; v++)
+                            if (bitmap[v])
+                                frontier.push_back(v);
+
+                        bitmap.clear();
+                        nextBitmap.clear();
+                    }
+
+                    details::bfsPush(a, result.levels, depth, frontier, nextFrontier);
+                    std::swap(frontier, nextFrontier);
+                    frontierSize = frontier.size();
+                }
+
+                result.reached += frontierSize;
+
+                if (pull) {
+                    frontierEdges = 0;
+
+#pragma omp parallel for reduction(+:frontierEdges)
+                    for (size_t v = 0; v < n; v++)
+                        if (bitmap[v])
+                            frontierEdges += a.rowOffsets[v + 1] - a.rowOffsets[v];
+                }
+                else {
+                    frontierEdges = details::frontierEdges(a, frontier);
+                }
+
+                unexploredEdges -= std::min(unexploredEdges, frontierEdges);
+
+                auto end = std::chrono::steady_clock::now();
+                level.ms = std::chrono::duration<double, std::milli>(end - start).count();
+                result.trace.push_back(level);
+            }
+
+            return result;
+        }
+
+        struct MultiBfsResult {
+            size_t reachedPairs = 0;
+            size_t traversedEdges = 0;
+            size_t levels = 0;
+        };
+
+        /**
+         * Multi-source bfs, where each vertex carries bit frontier of Words x 64 traversals,
+         * so single level is one boolean row-parallel product of frontier words with the adjacency matrix.
+         *
+         * @param a Adjacency matrix, out edges are rows
+         * @param at Transposed adjacency matrix (same as a for undirected graph)
+         * @param sources Traversals sources, processed in batches of Words x 64
+         * @return Total number of reached (source, vertex) pairs, sum of out edges of reached vertices over all sources
+         *         and max number of levels in the batch
+         */
+        template<size_t Words>
+        inline MultiBfsResult multiSourceBfs(const CsrMatrix& a, const CsrMatrix& at, const std::vector<unsigned int>& sources) {
+            using Word = std::array<uint64_t, Words>;
+            const size_t lanesInWord = Words * 64;
+
+            assert(a.nrows == a.ncols);
+            assert(at.nrows == a.nrows && at.ncols == a.ncols);
+
+            size_t n = a.nrows;
+            MultiBfsResult result;
+
+            std::vector<Word> seen(n);
+            std::vector<Word> frontier(n);
+            std::vector<Word> next(n);
+
+            for (size_t first = 0; first < sources.size(); first += lanesInWord) {
+                size_t lanes = std::min(lanesInWord, sources.size() - first);
+
+                // Unused lanes of the last batch are marked as seen, so fully seen vertices are skipped uniformly
+                Word used{};
+                for (size_t l = 0; l < lanes; l++)
+                    used[l / 64] |= 1ull << (l % 64);
+
+#pragma omp parallel for
+                for (size_t v = 0; v < n; v++) {
+                    for (size_t w = 0; w < Words; w++) {
+                        seen[v][w] = ~used[w];
+                        frontier[v][w] = 0;
+                    }
+                }
+
+                for (size_t l = 0; l < lanes; l++) {
+                    auto s = sources[first + l];
+                    assert(s < n);
+                    seen[s][l / 64] |= 1ull << (l % 64);
+                    frontier[s][l / 64] |= 1ull << (l % 64);
+                }
+
+                size_t levels = 0;
+                size_t active = 1;
+
+                while (active > 0) {
+                    active = 0;
+
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+:active)
+                    for (size_t v = 0; v < n; v++) {
+                        Word s = seen[v];
+                        Word acc{};
+                        uint64_t full = ~0ull;
+
+                        for (size_t w = 0; w < Words; w++)
+                            full &= s[w];
+
+                        if (full != ~0ull) {
+                            for (size_t e = at.rowOffsets[v]; e < at.rowOffsets[v + 1]; e++) {
+                                const Word& f = frontier[at.colIndices[e]];
+                                for (size_t w = 0; w < Words; w++)
+                                    acc[w] |= f[w];
+                            }
+                        }
+
+                        uint64_t any = 0;
+                        for (size_t w = 0; w < Words; w++) {
+                            acc[w] &= ~s[w];
+                            seen[v][w] = s[w] | acc[w];
+                            any |= acc[w];
+                        }
+
+                        next[v] = acc;
+                        active += any != 0;
+                    }
+
+                    std::swap(frontier, next);
+                    levels += 1;
+                }
+
+                size_t reachedPairs = 0;
+                size_t traversedEdges = 0;
+
+#pragma omp parallel for reduction(+:reachedPairs, traversedEdges)
+                for (size_t v = 0; v < n; v++) {
+                    size_t count = 0;
+                    for (size_t w = 0; w < Words; w++)
+                        count += __builtin_popcountll(seen[v][w] & used[w]);
+
+                    reachedPairs += count;
+                    traversedEdges += count * (a.rowOffsets[v + 1] - a.rowOffsets[v]);
+                }
+
+                result.reachedPairs += reachedPairs;
+                result.traversedEdges += traversedEdges;
+                result.levels = std::max(result.levels, levels);
+            }
+
+            return result;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_BFS_HPP
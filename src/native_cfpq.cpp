@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <labeled_graph_loader.hpp>
+#include <grammar.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_ewise.hpp>
+
+#include <unordered_map>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Cfpq : public BenchmarkBase {
+    public:
+
+        Cfpq(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            grammar = Grammar(getGrammarPath());
+
+            // Stop (not converged) if the index grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+
+            benchmarkName = "Native-CFPQ-" + getGrammarName();
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Cfpq() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        std::string getGrammarPath() const {
+            return argsProcessor.getOption("grammar", "data/grammars/same_generation.txt");
+        }
+
+        std::string getGrammarName() const {
+            auto path = getGrammarPath();
+            auto name = path.substr(path.find_last_of('/') + 1);
+            return name.substr(0, name.find_last_of('.'));
+        }
+
+        void setupBenchmark() override {
+            grammar.loadData();
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            LabeledGraphLoader loader(file, type);
+            loader.loadData();
+
+            n = loader.getVerticesCount();
+
+            for (auto& label: loader.getLabels()) {
+                labels[label.name] = native::cooToCsr(label.matrix);
+
+#ifdef BENCH_DEBUG
+                log << ">   Load label: \"" << label.name << "\" of \"" << file << "\" isUndirected: " << type << std::endl
+                    << "                 size: " << n << " x " << n << " nvals: " << label.matrix.nvals << std::endl;
+#endif // BENCH_DEBUG
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            labels.clear();
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            iterations = 0;
+            mxmCalls = 0;
+            addCalls = 0;
+            converged = false;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+            double mxmMs = 0.0;
+            double addMs = 0.0;
+
+            T.assign(grammar.getNonterminalsCount(), native::emptyCsr(n, n));
+
+            for (auto left: grammar.getEpsRules()) {
+                T[left] = native::add(T[left], native::identityCsr(n));
+            }
+
+            for (auto& rule: grammar.getTerminalRules()) {
+                auto found = labels.find(rule.terminal);
+                if (found != labels.end())
+                    T[rule.left] = native::add(T[rule.left], found->second);
+            }
+
+            bool changed = true;
+
+            while (changed && !exceedsBudget()) {
+                changed = false;
+                iterations += 1;
+
+                for (auto& rule: grammar.getBinaryRules()) {
+                    timer.start();
+                    auto P = native::multiply(T[rule.first], T[rule.second]);
+                    timer.end();
+                    mxmMs += timer.getElapsedTimeMs();
+                    mxmCalls += 1;
+
+                    timer.start();
+                    auto N = native::add(T[rule.left], P);
+                    timer.end();
+                    addMs += timer.getElapsedTimeMs();
+                    addCalls += 1;
+
+                    changed = changed || N.nvals() != T[rule.left].nvals();
+                    T[rule.left] = std::move(N);
+                }
+            }
+
+            converged = !changed;
+
+            addStageSample("mxm", mxmMs);
+            addStageSample("add", addMs);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            addMetric("iterations", (double) iterations);
+            addMetric("mxm calls", (double) mxmCalls);
+            addMetric("add calls", (double) addCalls);
+            addMetric("nvals", (double) T[grammar.getStart()].nvals());
+            addMetric("converged", converged ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            for (size_t i = 0; i < T.size(); i++) {
+                log << "   Nonterminal " << grammar.getNonterminal(i) << ": size " << n << " x " << n
+                    << " nvals " << T[i].nvals() << std::endl;
+            }
+
+            log << "   Result: iterations " << iterations << " mxm calls " << mxmCalls << " add calls " << addCalls
+                << " converged " << converged << std::endl;
+#endif
+
+            T.clear();
+        }
+
+        bool exceedsBudget() const {
+            if (maxNvals == 0)
+                return false;
+
+            size_t total = 0;
+            for (auto& t: T) {
+                total += t.nvals();
+            }
+
+            return total > maxNvals;
+        }
+
+    protected:
+
+        ArgsProcessor argsProcessor;
+        Grammar grammar;
+
+        size_t n = 0;
+        std::unordered_map<std::string, native::CsrMatrix> labels;
+        std::vector<native::CsrMatrix> T;
+
+        size_t maxNvals;
+        size_t iterations = 0;
+        size_t mxmCalls = 0;
+        size_t addCalls = 0;
+        bool converged = false;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Cfpq cfpq(argc, argv);
+    cfpq.runBenchmark();
+    return 0;
+}
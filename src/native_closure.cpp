@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_ewise.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Closure : public BenchmarkBase {
+    public:
+
+        Closure(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // squaring: R = R + R x R until fixpoint
+            // seminaive: D = (D x A) \ R, R = R + D until D is empty
+            mode = argsProcessor.getOption("mode", "squaring");
+            assert(mode == "squaring" || mode == "seminaive");
+
+            // Stop (not converged) if closure grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+            maxSteps = std::stoull(argsProcessor.getOption("max-steps", "0"));
+
+            benchmarkName = "Native-Closure-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Closure() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Step {
+            size_t nvals;
+            size_t deltaNvals;
+            double mxmMs;
+            double addMs;
+            double diffMs;
+        };
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::cooToCsr(input);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            steps.clear();
+            converged = false;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+            R = A;
+
+            if (mode == "squaring") {
+                while (!stop()) {
+                    Step step{};
+
+                    timer.start();
+                    auto P = native::multiply(R, R);
+                    timer.end();
+                    step.mxmMs = timer.getElapsedTimeMs();
+
+                    timer.start();
+                    auto N = native::add(R, P);
+                    timer.end();
+                    step.addMs = timer.getElapsedTimeMs();
+
+                    step.deltaNvals = N.nvals() - R.nvals();
+                    step.nvals = N.nvals();
+                    converged = step.deltaNvals == 0;
+
+                    R = std::move(N);
+                    steps.push_back(step);
+                }
+            }
+            else {
+                native::CsrMatrix D = A;
+
+                while (!stop()) {
+                    Step step{};
+
+                    timer.start();
+                    auto P = native::multiply(D, A);
+                    timer.end();
+                    step.mxmMs = timer.getElapsedTimeMs();
+
+                    timer.start();
+                    D = native::subtract(P, R);
+                    timer.end();
+                    step.diffMs = timer.getElapsedTimeMs();
+
+                    timer.start();
+                    R = native::add(R, D);
+                    timer.end();
+                    step.addMs = timer.getElapsedTimeMs();
+
+                    step.deltaNvals = D.nvals();
+                    step.nvals = R.nvals();
+                    converged = step.deltaNvals == 0;
+
+                    steps.push_back(step);
+                }
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Step total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.mxmMs += step.mxmMs;
+                total.addMs += step.addMs;
+                total.diffMs += step.diffMs;
+
+#ifdef BENCH_DEBUG
+                log << "   step " << i << ": nvals " << step.nvals << " (+" << step.deltaNvals << ")"
+                    << " mxm " << step.mxmMs << " ms add " << step.addMs << " ms";
+                if (mode == "seminaive")
+                    log << " diff " << step.diffMs << " ms";
+                log << std::endl;
+#endif
+            }
+
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("add", total.addMs);
+            if (mode == "seminaive")
+                addStageSample("diff", total.diffMs);
+
+            addMetric("steps", (double) steps.size());
+            addMetric("nvals", (double) R.nvals());
+            addMetric("converged", converged ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << R.nrows << " x " << R.ncols
+                << " nvals " << R.nvals() << " steps " << steps.size() << " converged " << converged << std::endl;
+#endif
+
+            R = native::CsrMatrix{};
+        }
+
+        bool stop() const {
+            return converged ||
+                   (maxNvals > 0 && R.nvals() > maxNvals) ||
+                   (maxSteps > 0 && steps.size() >= maxSteps);
+        }
+
+    protected:
+
+        native::CsrMatrix A;
+        native::CsrMatrix R;
+
+        std::string mode;
+        size_t maxNvals;
+        size_t maxSteps;
+
+        std::vector<Step> steps;
+        bool converged = false;
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Closure closure(argc, argv);
+    closure.runBenchmark();
+    return 0;
+}
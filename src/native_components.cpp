@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_components.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Components : public BenchmarkBase {
+    public:
+
+        Components(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // afforest: neighbors sampling with union-find, lp: label propagation of minimal vertex
+            algorithm = argsProcessor.getOption("algorithm", "afforest");
+            assert(algorithm == "afforest" || algorithm == "lp");
+
+            benchmarkName = "Native-Components-" + algorithm;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Components() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            // Components of directed graph are weakly connected ones, so graph is always loaded as undirected
+            MatrixLoader loader(file, true);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << " (loaded as undirected)" << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::cooToCsr(input);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (algorithm == "afforest")
+                result = native::afforest(A);
+            else
+                result = native::labelPropagation(A);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            std::map<std::string, double> phases;
+
+            for (size_t i = 0; i < result.trace.size(); i++) {
+                auto& step = result.trace[i];
+                phases[step.phase] += step.ms;
+
+#ifdef BENCH_DEBUG
+                log << "   step " << i << " (" << step.phase << "): count " << step.count << " " << step.ms << " ms" << std::endl;
+#endif
+            }
+
+            for (auto& phase: phases)
+                addStageSample(phase.first, phase.second);
+
+            auto signature = componentsSignature(result.labels);
+            auto components = std::stoull(signature.substr(0, signature.find(':')));
+
+            addMetric("iterations", (double) result.trace.size());
+            addMetric("components", (double) components);
+
+#ifdef BENCH_DEBUG
+            log << "   Result: components " << components << " signature " << signature << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, true) + ":components", signature);
+
+            result = native::ComponentsResult{};
+        }
+
+    protected:
+
+        native::CsrMatrix A;
+        native::ComponentsResult result;
+
+        std::string algorithm;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Components components(argc, argv);
+    components.runBenchmark();
+    return 0;
+}
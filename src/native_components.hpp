@@ -0,0 +1,218 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_COMPONENTS_HPP
+#define SPBENCH_NATIVE_COMPONENTS_HPP
+
+#include <native_csr.hpp>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <omp.h>
+
+namespace benchmark {
+    namespace native {
+
+        /** Statistics of the single phase (iteration) of components labeling */
+        struct ComponentsStep {
+            std::string phase;
+            // Changed labels for label propagation sweep, processed vertices (samples) for afforest phases
+            size_t count = 0;
+            double ms = 0.0;
+        };
+
+        struct ComponentsResult {
+            std::vector<unsigned int> labels;
+            std::vector<ComponentsStep> trace;
+        };
+
+        namespace details {
+
+            /** Hooks root with greater id to root with smaller one, so root of each tree is its minimal vertex */
+            inline void link(std::vector<unsigned int>& comp, unsigned int u, unsigned int v) {
+                unsigned int p1 = __atomic_load_n(&comp[u], __ATOMIC_RELAXED);
+                unsigned int p2 = __atomic_load_n(&comp[v], __ATOMIC_RELAXED);
+
+                while (p1 != p2) {
+                    unsigned int high = std::max(p1, p2);
+                    unsigned int low = std::min(p1, p2);
+                    unsigned int pHigh = __atomic_load_n(&comp[high], __ATOMIC_RELAXED);
+
+                    if (pHigh == low)
+                        break;
+
+                    if (pHigh == high &&
+                        __atomic_compare_exchange_n(&comp[high], &pHigh, low, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                        break;
+
+                    p1 = __atomic_load_n(&comp[__atomic_load_n(&comp[high], __ATOMIC_RELAXED)], __ATOMIC_RELAXED);
+                    p2 = __atomic_load_n(&comp[low], __ATOMIC_RELAXED);
+                }
+            }
+
+            inline void compress(std::vector<unsigned int>& comp) {
+#pragma omp parallel for schedule(dynamic, 16384)
+                for (size_t v = 0; v < comp.size(); v++) {
+                    while (comp[v] != comp[comp[v]])
+                        comp[v] = comp[comp[v]];
+                }
+            }
+
+            template<typename F>
+            void timedStep(std::vector<ComponentsStep>& trace, const std::string& phase, F&& f) {
+                auto start = std::chrono::steady_clock::now();
+                ComponentsStep step;
+                step.phase = phase;
+                step.count = f();
+                auto end = std::chrono::steady_clock::now();
+                step.ms = std::chrono::duration<double, std::milli>(end - start).count();
+                trace.push_back(step);
+            }
+
+        }
+
+        /**
+         * Afforest (Sutton et al.): link first neighbors of each vertex, find the largest intermediate component
+         * by sampling and process the rest of the neighbors only for vertices outside of it.
+         * Adjacency matrix must be symmetric. Label of vertex is the minimal vertex of its component.
+         */
+        inline ComponentsResult afforest(const CsrMatrix& a, size_t neighborRounds = 2, size_t samples = 1024) {
+            assert(a.nrows == a.ncols);
+
+            size_t n = a.nrows;
+            ComponentsResult result;
+            auto& comp = result.labels;
+
+            comp.resize(n);
+            for (size_t v = 0; v < n; v++)
+                comp[v] = v;
+
+            for (size_t r = 0; r < neighborRounds; r++) {
+                details::timedStep(result.trace, "link", [&]() {
+                    size_t processed = 0;
+
+#pragma omp parallel for schedule(dynamic, 16384) reduction(+:processed)
+                    for (size_t u = 0; u < n; u++) {
+                        size_t e = a.rowOffsets[u] + r;
+                        if (e < a.rowOffsets[u + 1]) {
+                            details::link(comp, u, a.colIndices[e]);
+                            processed += 1;
+                        }
+                    }
+
+                    details::compress(comp);
+                    return processed;
+                });
+            }
+
+            unsigned int largest = 0;
+
+            details::timedStep(result.trace, "sample", [&]() {
+                std::mt19937 engine(27491095);
+                std::unordered_map<unsigned int, size_t> counts;
+                size_t best = 0;
+
+                for (size_t s = 0; s < samples && n > 0; s++) {
+                    auto label = comp[engine() % n];
+                    auto count = ++counts[label];
+                    if (count > best) {
+                        best = count;
+                        largest = label;
+                    }
+                }
+
+                return best;
+            });
+
+            details::timedStep(result.trace, "finish", [&]() {
+                size_t skipped = 0;
+
+#pragma omp parallel for schedule(dynamic, 16384) reduction(+:skipped)
+                for (size_t u = 0; u < n; u++) {
+                    if (comp[u] == largest) {
+                        skipped += 1;
+                        continue;
+                    }
+
+                    for (size_t e = a.rowOffsets[u] + neighborRounds; e < a.rowOffsets[u + 1]; e++)
+                        details::link(comp, u, a.colIndices[e]);
+                }
+
+                details::compress(comp);
+                return n - skipped;
+            });
+
+            return result;
+        }
+
+        /**
+         * Label propagation: each vertex takes minimal label among itself and its neighbors until no label changes.
+         * Labels are updated in place, so the change is propagated further within the same sweep.
+         * Adjacency matrix must be symmetric. Label of vertex is the minimal vertex of its component.
+         */
+        inline ComponentsResult labelPropagation(const CsrMatrix& a) {
+            assert(a.nrows == a.ncols);
+
+            size_t n = a.nrows;
+            ComponentsResult result;
+            auto& labels = result.labels;
+
+            labels.resize(n);
+            for (size_t v = 0; v < n; v++)
+                labels[v] = v;
+
+            size_t changed = 1;
+
+            while (changed > 0) {
+                details::timedStep(result.trace, "sweep", [&]() {
+                    changed = 0;
+
+#pragma omp parallel for schedule(dynamic, 16384) reduction(+:changed)
+                    for (size_t v = 0; v < n; v++) {
+                        unsigned int current = __atomic_load_n(&labels[v], __ATOMIC_RELAXED);
+                        unsigned int label = current;
+
+                        for (size_t e = a.rowOffsets[v]; e < a.rowOffsets[v + 1]; e++)
+                            label = std::min(label, __atomic_load_n(&labels[a.colIndices[e]], __ATOMIC_RELAXED));
+
+                        if (label < current) {
+                            __atomic_store_n(&labels[v], label, __ATOMIC_RELAXED);
+                            changed += 1;
+                        }
+                    }
+
+                    return changed;
+                });
+            }
+
+            return result;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_COMPONENTS_HPP
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Convert : public BenchmarkBase {
+    public:
+
+        Convert(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            benchmarkName = "Native-Convert";
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Convert() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            const double indexBytes = sizeof(unsigned int);
+            const double offsetBytes = sizeof(size_t);
+            const double nvals = (double) input.nvals;
+            const double nrows = (double) input.nrows;
+            const double ncols = (double) input.ncols;
+
+            Timer timer;
+
+            // Effective bandwidth: bytes of input read plus bytes of output written
+            timer.start();
+            csr = native::cooToCsr(input);
+            timer.end();
+            report("coo->csr", timer.getElapsedTimeMs(), 3.0 * indexBytes * nvals + offsetBytes * (nrows + 1));
+
+            timer.start();
+            csc = native::cooToCsc(input);
+            timer.end();
+            report("coo->csc", timer.getElapsedTimeMs(), 3.0 * indexBytes * nvals + offsetBytes * (ncols + 1));
+
+            timer.start();
+            transposed = native::transpose(csr);
+            timer.end();
+            report("transpose", timer.getElapsedTimeMs(), 2.0 * indexBytes * nvals + offsetBytes * (nrows + ncols + 2));
+
+            timer.start();
+            dcsr = native::csrToDcsr(csr);
+            timer.end();
+            report("csr->dcsr", timer.getElapsedTimeMs(), 2.0 * indexBytes * nvals + offsetBytes * (nrows + 1)
+                                                         + (indexBytes + offsetBytes) * (double) dcsr.nzr() + offsetBytes);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+#ifdef BENCH_DEBUG
+            log << "   Result matrices: csr nvals " << csr.nvals() << " csc nvals " << csc.nvals()
+                << " transposed nvals " << transposed.nvals() << " dcsr nzr " << dcsr.nzr() << std::endl;
+#endif
+
+            assert(csc.rowOffsets == transposed.rowOffsets);
+            assert(csc.colIndices == transposed.colIndices);
+
+            csr = native::CsrMatrix{};
+            csc = native::CsrMatrix{};
+            transposed = native::CsrMatrix{};
+            dcsr = native::DcsrMatrix{};
+        }
+
+        void report(const std::string& conversion, double ms, double bytes) {
+            addStageSample(conversion, ms);
+            addMetric(conversion + " GB/s", bytes / (ms * 1.0e6));
+        }
+
+    protected:
+
+        native::CsrMatrix csr;
+        native::CsrMatrix csc;
+        native::CsrMatrix transposed;
+        native::DcsrMatrix dcsr;
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Convert convert(argc, argv);
+    convert.runBenchmark();
+    return 0;
+}
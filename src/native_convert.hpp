@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_CONVERT_HPP
+#define SPBENCH_NATIVE_CONVERT_HPP
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <omp.h>
+#include <matrix.hpp>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+        namespace details {
+
+            /** Keys are scattered in blocks of 2^bits keys, so block histogram (2^14 x 8 bytes) fits into L2 */
+            static const size_t SCATTER_BLOCK_BITS = 14;
+
+            /** Number of input chunks for per-thread histograms */
+            inline size_t chunksCount(size_t nentries) {
+                size_t chunks = (size_t) omp_get_max_threads();
+                return std::max<size_t>(1, std::min(chunks, nentries));
+            }
+
+            /**
+             * Stable parallel bucketing of entries by key in [0, nkeys).
+             *
+             * Coarse pass: per-chunk histogram over key blocks, scan, scatter into temporary buffer grouped by blocks.
+             * Only few destinations are written at once here, so scatter does not thrash caches and TLB.
+             * Fine pass: per-block counting sort, block histogram and block output fit into cache.
+             *
+             * @param source Entries source: source(begin, end, f) calls f(key, value) for entries [begin, end) in input order
+             * @param offsets Output offsets of keys, size nkeys + 1
+             * @param values Output values grouped by key, input order is preserved within key
+             */
+            template<typename Index, typename Source>
+            void bucketByKey(size_t nkeys, size_t nentries, const Source& source,
+                             std::vector<size_t>& offsets, std::vector<Index>& values) {
+                const size_t blockSize = (size_t) 1 << SCATTER_BLOCK_BITS;
+                const size_t blockMask = blockSize - 1;
+                const size_t nblocks = (nkeys + blockSize - 1) / blockSize;
+                const size_t nchunks = chunksCount(nentries);
+
+                offsets.assign(nkeys + 1, 0);
+                values.resize(nentries);
+
+                if (nentries == 0)
+                    return;
+
+                // Block-major, chunk-minor layout: exclusive scan gives stable positions
+                std::vector<size_t> histogram(nblocks * nchunks, 0);
+                std::vector<Index> tmpKeys(nentries);
+                std::vector<Index> tmpValues(nentries);
+
+#pragma omp parallel for schedule(static)
+                for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                    source(nentries * chunk / nchunks, nentries * (chunk + 1) / nchunks, [&](Index key, Index) {
+                        histogram[(key >> SCATTER_BLOCK_BITS) * nchunks + chunk] += 1;
+                    });
+                }
+
+                size_t sum = 0;
+                for (auto& h: histogram) {
+                    size_t prev = sum;
+                    sum += h;
+                    h = prev;
+                }
+
+#pragma omp parallel for schedule(static)
+                for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                    std::vector<size_t> cursor(nblocks);
+                    for (size_t b = 0; b < nblocks; b++) {
+                        cursor[b] = histogram[b * nchunks + chunk];
+                    }
+
+                    source(nentries * chunk / nchunks, nentries * (chunk + 1) / nchunks, [&](Index key, Index value) {
+                        auto p = cursor[key >> SCATTER_BLOCK_BITS]++;
+                        tmpKeys[p] = key;
+                        tmpValues[p] = value;
+                    });
+                }
+
+#pragma omp parallel
+                {
+                    std::vector<size_t> count(blockSize + 1);
+
+#pragma omp for schedule(dynamic, 1)
+                    for (size_t b = 0; b < nblocks; b++) {
+                        size_t first = histogram[b * nchunks];
+                        size_t last = b + 1 < nblocks ? histogram[(b + 1) * nchunks] : nentries;
+                        size_t firstKey = b * blockSize;
+                        size_t keys = std::min(nkeys - firstKey, blockSize);
+
+                        std::fill(count.begin(), count.begin() + keys + 1, 0);
+
+                        for (size_t k = first; k < last; k++) {
+                            count[(tmpKeys[k] & blockMask) + 1] += 1;
+                        }
+
+                        for (size_t i = 0; i < keys; i++) {
+                            count[i + 1] += count[i];
+                        }
+
+                        for (size_t i = 0; i < keys; i++) {
+                            offsets[firstKey + i] = first + count[i];
+                        }
+
+                        for (size_t k = first; k < last; k++) {
+                            values[first + count[tmpKeys[k] & blockMask]++] = tmpValues[k];
+                        }
+                    }
+                }
+
+                offsets[nkeys] = nentries;
+            }
+
+            /** Sort rows, which are not sorted (input coo may have arbitrary order of entries) */
+            template<typename Index>
+            inline void sortRows(std::vector<size_t>& offsets, std::vector<Index>& values) {
+                const size_t nrows = offsets.size() - 1;
+
+#pragma omp parallel for schedule(dynamic, 1024)
+                for (size_t i = 0; i < nrows; i++) {
+                    auto first = values.begin() + offsets[i];
+                    auto last = values.begin() + offsets[i + 1];
+
+                    if (!std::is_sorted(first, last))
+                        std::sort(first, last);
+                }
+            }
+
+        }
+
+        /** Coo to csr conversion, coo entries may go in any order */
+        template<typename Index>
+        inline CsrMatrixT<Index> cooToCsr(const MatrixT<Index>& m) {
+            CsrMatrixT<Index> csr;
+            csr.nrows = m.nrows;
+            csr.ncols = m.ncols;
+
+            details::bucketByKey(m.nrows, m.nvals, [&](size_t begin, size_t end, auto&& f) {
+                for (size_t k = begin; k < end; k++) {
+                    f(m.rows[k], m.cols[k]);
+                }
+            }, csr.rowOffsets, csr.colIndices);
+
+            details::sortRows(csr.rowOffsets, csr.colIndices);
+
+            return csr;
+        }
+
+        /**
+         * Coo to csc conversion, coo entries may go in any order
+         * @return Csc of A, stored as csr of A^T
+         */
+        inline CsrMatrix cooToCsc(const Matrix& m) {
+            CsrMatrix csc;
+            csc.nrows = m.ncols;
+            csc.ncols = m.nrows;
+
+            details::bucketByKey(m.ncols, m.nvals, [&](size_t begin, size_t end, auto&& f) {
+                for (size_t k = begin; k < end; k++) {
+                    f(m.cols[k], m.rows[k]);
+                }
+            }, csc.rowOffsets, csc.colIndices);
+
+            details::sortRows(csc.rowOffsets, csc.colIndices);
+
+            return csc;
+        }
+
+        /**
+         * Explicit transpose.
+         * Rows of A are visited in order and bucketing is stable, so rows of the result are sorted automatically.
+         * @return Csr of A^T, which is the same as csc of A
+         */
+        inline CsrMatrix transpose(const CsrMatrix& a) {
+            CsrMatrix t;
+            t.nrows = a.ncols;
+            t.ncols = a.nrows;
+
+            details::bucketByKey(a.ncols, a.nvals(), [&](size_t begin, size_t end, auto&& f) {
+                if (begin == end)
+                    return;
+
+                size_t row = std::upper_bound(a.rowOffsets.begin(), a.rowOffsets.end(), begin) - a.rowOffsets.begin() - 1;
+
+                for (size_t k = begin; k < end; k++) {
+                    while (a.rowOffsets[row + 1] <= k)
+                        row += 1;
+
+                    f(a.colIndices[k], (unsigned int) row);
+                }
+            }, t.rowOffsets, t.colIndices);
+
+            return t;
+        }
+
+        /** Csr to dcsr conversion, empty rows are dropped */
+        inline DcsrMatrix csrToDcsr(const CsrMatrix& a) {
+            const size_t nchunks = details::chunksCount(a.nrows);
+
+            DcsrMatrix d;
+            d.nrows = a.nrows;
+            d.ncols = a.ncols;
+
+            std::vector<size_t> nonEmpty(nchunks + 1, 0);
+
+#pragma omp parallel for schedule(static)
+            for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                size_t count = 0;
+                for (size_t i = a.nrows * chunk / nchunks; i < a.nrows * (chunk + 1) / nchunks; i++) {
+                    count += a.rowOffsets[i] != a.rowOffsets[i + 1] ? 1 : 0;
+                }
+                nonEmpty[chunk + 1] = count;
+            }
+
+            for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                nonEmpty[chunk + 1] += nonEmpty[chunk];
+            }
+
+            d.rowIndices.resize(nonEmpty[nchunks]);
+            d.rowOffsets.resize(nonEmpty[nchunks] + 1);
+            d.colIndices.resize(a.nvals());
+
+#pragma omp parallel for schedule(static)
+            for (size_t chunk = 0; chunk < nchunks; chunk++) {
+                size_t pos = nonEmpty[chunk];
+                for (size_t i = a.nrows * chunk / nchunks; i < a.nrows * (chunk + 1) / nchunks; i++) {
+                    if (a.rowOffsets[i] != a.rowOffsets[i + 1]) {
+                        d.rowIndices[pos] = (unsigned int) i;
+                        d.rowOffsets[pos] = a.rowOffsets[i];
+                        pos += 1;
+                    }
+                }
+
+                size_t first = a.nvals() * chunk / nchunks;
+                size_t last = a.nvals() * (chunk + 1) / nchunks;
+                std::copy(a.colIndices.begin() + first, a.colIndices.begin() + last, d.colIndices.begin() + first);
+            }
+
+            d.rowOffsets[d.nzr()] = a.nvals();
+
+            return d;
+        }
+
+        /**
+         * Csr matrix with cached csc mirror (csr of transposed matrix).
+         * Mirror is built on the first access, so products with A^T pay transpose only once.
+         */
+        class MirroredMatrix {
+        public:
+            MirroredMatrix() = default;
+
+            explicit MirroredMatrix(CsrMatrix csr) : mCsr(std::move(csr)) {
+
+            }
+
+            const CsrMatrix& csr() const {
+                return mCsr;
+            }
+
+            const CsrMatrix& csc() {
+                if (!mHasCsc) {
+                    mCsc = transpose(mCsr);
+                    mHasCsc = true;
+                }
+
+                return mCsc;
+            }
+
+            bool hasCsc() const {
+                return mHasCsc;
+            }
+
+            void dropCsc() {
+                mCsc = CsrMatrix{};
+                mHasCsc = false;
+            }
+
+        private:
+            CsrMatrix mCsr;
+            CsrMatrix mCsc;
+            bool mHasCsc = false;
+        };
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_CONVERT_HPP
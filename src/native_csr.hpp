@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_CSR_HPP
+#define SPBENCH_NATIVE_CSR_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+namespace benchmark {
+    namespace native {
+
+        /**
+         * Boolean matrix in compressed sparse rows format, column indices within row are sorted.
+         * Offsets are always 64-bit, column indices are of type Index (see MatrixT).
+         */
+        template<typename Index>
+        struct CsrMatrixT {
+            using index_type = Index;
+
+            size_t nrows = 0;
+            size_t ncols = 0;
+            std::vector<size_t> rowOffsets;
+            std::vector<Index> colIndices;
+
+            CsrMatrixT() = default;
+            CsrMatrixT(const CsrMatrixT& m) = default;
+            CsrMatrixT(CsrMatrixT&& m) noexcept = default;
+
+            CsrMatrixT& operator=(const CsrMatrixT& m) = default;
+            CsrMatrixT& operator=(CsrMatrixT&& m) noexcept = default;
+
+            size_t nvals() const {
+                return colIndices.size();
+            }
+
+            /** @return Size of the offsets and columns in bytes */
+            size_t sizeBytes() const {
+                return sizeof(size_t) * rowOffsets.size() + sizeof(Index) * colIndices.size();
+            }
+        };
+
+        using CsrMatrix = CsrMatrixT<unsigned int>;
+        using CsrMatrix64 = CsrMatrixT<uint64_t>;
+
+        /** Boolean matrix in doubly compressed sparse rows format, only non-empty rows are stored */
+        struct DcsrMatrix {
+            size_t nrows = 0;
+            size_t ncols = 0;
+            std::vector<unsigned int> rowIndices;
+            std::vector<size_t> rowOffsets;
+            std::vector<unsigned int> colIndices;
+
+            DcsrMatrix() = default;
+            DcsrMatrix(const DcsrMatrix& m) = default;
+            DcsrMatrix(DcsrMatrix&& m) noexcept = default;
+
+            DcsrMatrix& operator=(const DcsrMatrix& m) = default;
+            DcsrMatrix& operator=(DcsrMatrix&& m) noexcept = default;
+
+            size_t nvals() const {
+                return colIndices.size();
+            }
+
+            size_t nzr() const {
+                return rowIndices.size();
+            }
+        };
+
+        /** @return Matrix nrows x ncols without values */
+        inline CsrMatrix emptyCsr(size_t nrows, size_t ncols) {
+            CsrMatrix m;
+            m.nrows = nrows;
+            m.ncols = ncols;
+            m.rowOffsets.assign(nrows + 1, 0);
+            return m;
+        }
+
+        /** @return Identity matrix n x n */
+        inline CsrMatrix identityCsr(size_t n) {
+            CsrMatrix m;
+            m.nrows = n;
+            m.ncols = n;
+            m.rowOffsets.resize(n + 1);
+            m.colIndices.resize(n);
+
+            for (size_t i = 0; i < n; i++) {
+                m.rowOffsets[i] = i;
+                m.colIndices[i] = (unsigned int) i;
+            }
+
+            m.rowOffsets[n] = n;
+            return m;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_CSR_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_ewise.hpp>
+#include <native_runs.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Dynamic : public BenchmarkBase {
+    public:
+
+        Dynamic(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // incremental: C += A x dA + dA x (A + dA), full: C = (A + dA) x (A + dA) for each batch
+            mode = argsProcessor.getOption("mode", "incremental");
+            assert(mode == "incremental" || mode == "full");
+
+            // Stream of insertion batches is split off the dataset
+            batchesCount = std::stoull(argsProcessor.getOption("batches", "10"));
+            batchSize = std::stoull(argsProcessor.getOption("batch-size", "1000"));
+            seed = std::stoull(argsProcessor.getOption("seed", "1"));
+            assert(batchSize > 0);
+
+            benchmarkName = "Native-Dynamic-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Dynamic() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Batch {
+            size_t nvals;
+            size_t deltaNvals;
+            double updateMs;
+            double mxmMs;
+            double mergeMs;
+        };
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+
+            assert(input.nrows == input.ncols);
+
+            splitStream(input, batchesCount, batchSize, seed, base, batches);
+
+#ifdef BENCH_DEBUG
+            log << ">   Stream: base nvals " << base.nvals << " batches " << batches.size()
+                << " batch size " << batchSize << " seed " << seed << std::endl;
+#endif // BENCH_DEBUG
+
+            A0 = native::cooToCsr(base);
+            A0t = native::transpose(A0);
+            C0 = native::multiply(A0, A0);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            base = Matrix{};
+            batches.clear();
+            A0 = native::CsrMatrix{};
+            A0t = native::CsrMatrix{};
+            C0 = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Each iteration starts from the same base graph and its square
+            A = A0;
+            At = A0t;
+            C = native::RunMatrix(C0);
+            R = native::CsrMatrix{};
+            steps.clear();
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+
+            for (auto& batch: batches) {
+                Batch step{};
+
+                if (mode == "incremental") {
+                    // A and A^T are both kept, so A x dA is computed as (dA^T x A^T)^T over few rows
+                    timer.start();
+                    auto dA = native::cooToCsr(batch);
+                    auto dAt = native::transpose(dA);
+                    timer.end();
+                    step.updateMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    auto left = native::transpose(native::multiply(dAt, At));
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    A = native::add(A, dA);
+                    At = native::add(At, dAt);
+                    timer.end();
+                    step.updateMs += timer.getElapsedTimeMs();
+
+                    // dA x (A + dA) = dA x A + dA x dA
+                    timer.start();
+                    auto right = native::multiply(dA, A);
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    auto delta = native::add(left, right);
+                    step.deltaNvals = delta.nvals();
+                    C.append(std::move(delta));
+                    timer.end();
+                    step.mergeMs += timer.getElapsedTimeMs();
+
+                    step.nvals = C.storedNvals();
+                }
+                else {
+                    timer.start();
+                    A = native::add(A, native::cooToCsr(batch));
+                    timer.end();
+                    step.updateMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    R = native::multiply(A, A);
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+
+                    step.nvals = R.nvals();
+                }
+
+                steps.push_back(step);
+            }
+
+            // Runs are compacted once, when the result is requested
+            if (mode == "incremental") {
+                timer.start();
+                R = C.compact();
+                timer.end();
+
+                if (!steps.empty())
+                    steps.back().mergeMs += timer.getElapsedTimeMs();
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Batch total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.updateMs += step.updateMs;
+                total.mxmMs += step.mxmMs;
+                total.mergeMs += step.mergeMs;
+
+#ifdef BENCH_DEBUG
+                log << "   batch " << i << ": " << (mode == "incremental" ? "stored nvals " : "nvals ") << step.nvals;
+                if (mode == "incremental")
+                    log << " delta nvals " << step.deltaNvals;
+                log << " update " << step.updateMs << " ms mxm " << step.mxmMs << " ms merge " << step.mergeMs << " ms"
+                    << std::endl;
+#endif
+            }
+
+            double batchMs = total.updateMs + total.mxmMs + total.mergeMs;
+
+            addStageSample("update", total.updateMs);
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("merge", total.mergeMs);
+
+            addMetric("batches", (double) steps.size());
+            addMetric("batch ms", steps.empty() ? 0.0 : batchMs / (double) steps.size());
+            addMetric("nvals", (double) R.nvals());
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols << " nvals " << R.nvals() << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":dynamic-square-" + std::to_string(batchesCount) + "-" +
+                             std::to_string(batchSize) + "-" + std::to_string(seed), std::to_string(R.nvals()));
+
+            A = native::CsrMatrix{};
+            At = native::CsrMatrix{};
+            C = native::RunMatrix{};
+            R = native::CsrMatrix{};
+        }
+
+    protected:
+
+        native::CsrMatrix A0;
+        native::CsrMatrix A0t;
+        native::CsrMatrix C0;
+
+        native::CsrMatrix A;
+        native::CsrMatrix At;
+        native::RunMatrix C;
+        native::CsrMatrix R;
+
+        std::string mode;
+        size_t batchesCount;
+        size_t batchSize;
+        size_t seed;
+
+        Matrix base;
+        std::vector<Matrix> batches;
+        std::vector<Batch> steps;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Dynamic dynamic(argc, argv);
+    dynamic.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_EWISE_HPP
+#define SPBENCH_NATIVE_EWISE_HPP
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+        namespace details {
+
+            /**
+             * Row-parallel element-wise operation over sorted rows.
+             * Merge(first a, last a, first b, last b, out) writes result row and returns past-the-end iterator,
+             * it is called once with counting output to size rows, and once to fill them.
+             */
+            template<typename Merge>
+            CsrMatrix ewise(const CsrMatrix& a, const CsrMatrix& b, Merge merge) {
+                assert(a.nrows == b.nrows);
+                assert(a.ncols == b.ncols);
+
+                struct Counter {
+                    size_t count = 0;
+                    Counter& operator*() { return *this; }
+                    Counter& operator++() { count += 1; return *this; }
+                    Counter operator++(int) { auto prev = *this; count += 1; return prev; }
+                    Counter& operator=(unsigned int) { return *this; }
+                };
+
+                CsrMatrix c;
+                c.nrows = a.nrows;
+                c.ncols = a.ncols;
+                c.rowOffsets.assign(a.nrows + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+                for (size_t i = 0; i < a.nrows; i++) {
+                    auto aFirst = a.colIndices.begin() + a.rowOffsets[i];
+                    auto aLast = a.colIndices.begin() + a.rowOffsets[i + 1];
+                    auto bFirst = b.colIndices.begin() + b.rowOffsets[i];
+                    auto bLast = b.colIndices.begin() + b.rowOffsets[i + 1];
+
+                    c.rowOffsets[i + 1] = merge(aFirst, aLast, bFirst, bLast, Counter{}).count;
+                }
+
+                for (size_t i = 0; i < c.nrows; i++) {
+                    c.rowOffsets[i + 1] += c.rowOffsets[i];
+                }
+
+                c.colIndices.resize(c.rowOffsets[c.nrows]);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+                for (size_t i = 0; i < a.nrows; i++) {
+                    auto aFirst = a.colIndices.begin() + a.rowOffsets[i];
+                    auto aLast = a.colIndices.begin() + a.rowOffsets[i + 1];
+                    auto bFirst = b.colIndices.begin() + b.rowOffsets[i];
+                    auto bLast = b.colIndices.begin() + b.rowOffsets[i + 1];
+
+                    merge(aFirst, aLast, bFirst, bLast, c.colIndices.begin() + c.rowOffsets[i]);
+                }
+
+                return c;
+            }
+
+        }
+
+        /** Boolean C = A + B (union of patterns) */
+        inline CsrMatrix add(const CsrMatrix& a, const CsrMatrix& b) {
+            return details::ewise(a, b, [](auto aFirst, auto aLast, auto bFirst, auto bLast, auto out) {
+                return std::set_union(aFirst, aLast, bFirst, bLast, out);
+            });
+        }
+
+        /** Boolean C = A \ B (entries of A, which are not in B) */
+        inline CsrMatrix subtract(const CsrMatrix& a, const CsrMatrix& b) {
+            return details::ewise(a, b, [](auto aFirst, auto aLast, auto bFirst, auto bLast, auto out) {
+                return std::set_difference(aFirst, aLast, bFirst, bLast, out);
+            });
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_EWISE_HPP
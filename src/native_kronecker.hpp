@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_KRONECKER_HPP
+#define SPBENCH_NATIVE_KRONECKER_HPP
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+
+        /**
+         * Boolean C = A (x) B, Kronecker product.
+         * Row i * B.nrows + j of C is row i of A, where each entry k is replaced by row j of B shifted by k * B.ncols,
+         * so rows are written in final sorted order and no sort is required. Rows are computed in parallel.
+         */
+        inline CsrMatrix kronecker(const CsrMatrix& a, const CsrMatrix& b) {
+            assert(a.ncols * b.ncols <= (size_t) std::numeric_limits<unsigned int>::max());
+
+            CsrMatrix c;
+            c.nrows = a.nrows * b.nrows;
+            c.ncols = a.ncols * b.ncols;
+            c.rowOffsets.assign(c.nrows + 1, 0);
+
+#pragma omp parallel for schedule(static)
+            for (size_t r = 0; r < c.nrows; r++) {
+                size_t i = r / b.nrows;
+                size_t j = r % b.nrows;
+
+                c.rowOffsets[r + 1] = (a.rowOffsets[i + 1] - a.rowOffsets[i]) * (b.rowOffsets[j + 1] - b.rowOffsets[j]);
+            }
+
+            for (size_t r = 0; r < c.nrows; r++) {
+                c.rowOffsets[r + 1] += c.rowOffsets[r];
+            }
+
+            c.colIndices.resize(c.rowOffsets[c.nrows]);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (size_t r = 0; r < c.nrows; r++) {
+                size_t i = r / b.nrows;
+                size_t j = r % b.nrows;
+                size_t pos = c.rowOffsets[r];
+
+                for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                    size_t shift = a.colIndices[k] * b.ncols;
+
+                    for (size_t l = b.rowOffsets[j]; l < b.rowOffsets[j + 1]; l++) {
+                        c.colIndices[pos++] = (unsigned int) (shift + b.colIndices[l]);
+                    }
+                }
+            }
+
+            return c;
+        }
+
+        /** @return Columns [first, first + count) of A as nrows x count matrix */
+        inline CsrMatrix columnsBlock(const CsrMatrix& a, size_t first, size_t count) {
+            CsrMatrix c;
+            c.nrows = a.nrows;
+            c.ncols = count;
+            c.rowOffsets.assign(a.nrows + 1, 0);
+
+            auto range = [&](size_t i) {
+                auto rowFirst = a.colIndices.begin() + a.rowOffsets[i];
+                auto rowLast = a.colIndices.begin() + a.rowOffsets[i + 1];
+                return std::make_pair(std::lower_bound(rowFirst, rowLast, (unsigned int) first),
+                                      std::lower_bound(rowFirst, rowLast, (unsigned int) (first + count)));
+            };
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (size_t i = 0; i < a.nrows; i++) {
+                auto r = range(i);
+                c.rowOffsets[i + 1] = r.second - r.first;
+            }
+
+            for (size_t i = 0; i < a.nrows; i++) {
+                c.rowOffsets[i + 1] += c.rowOffsets[i];
+            }
+
+            c.colIndices.resize(c.rowOffsets[a.nrows]);
+
+#pragma omp parallel for schedule(dynamic, 1024)
+            for (size_t i = 0; i < a.nrows; i++) {
+                auto r = range(i);
+                auto out = c.colIndices.begin() + c.rowOffsets[i];
+
+                for (auto it = r.first; it != r.second; ++it) {
+                    *(out++) = (unsigned int) (*it - first);
+                }
+            }
+
+            return c;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_KRONECKER_HPP
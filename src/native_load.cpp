@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_sharded_loader.hpp>
+#include <matrix_writer.hpp>
+#include <matrix_codec.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <fstream>
+#include <cstdint>
+#include <cstdio>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Load : public BenchmarkBase {
+    public:
+
+        Load(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // mtx: Matrix Market text
+            // csr: raw binary csr, see MatrixWriter::saveCsr
+            // csrz: compressed csr, see CompressedCsr
+            format = argsProcessor.getOption("format", "csrz");
+            assert(format == "mtx" || format == "csr" || format == "csrz");
+
+            // Dataset is written into this file (with format extension) in experiment setup and removed after
+            path = argsProcessor.getOption("path", "Load-Dataset") + "." + format;
+
+            // coo: MatrixLoader into coo matrix, as benchmarks load inputs
+            // sharded: two-pass ShardedLoader of mtx file straight into csr
+            loaderKind = argsProcessor.getOption("loader", "coo");
+            assert(loaderKind == "coo" || (loaderKind == "sharded" && format == "mtx"));
+
+            benchmarkName = "Native-Load-" + format;
+            if (loaderKind == "sharded")
+                benchmarkName += "-sharded";
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Load() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            expected = fingerprintCoo(input.nvals, input.rows.data(), input.cols.data());
+
+            Timer timer;
+            timer.start();
+
+            MatrixWriter writer;
+
+            if (format == "mtx")
+                writer.save(path, input);
+            else if (format == "csr")
+                writer.saveCsr(path, input);
+            else
+                writer.saveCsrz(path, input);
+
+            timer.end();
+
+            if (!writer.error.empty())
+                throw std::runtime_error(writer.error + ": " + path);
+
+            // Raw csr size is the baseline of compression
+            size_t rawBytes = 8 + 3 * sizeof(uint64_t) + sizeof(uint64_t) * (input.nrows + 1) + sizeof(uint32_t) * input.nvals;
+            size_t fileBytes = fileSize(path);
+
+            addMetric("file MB", (double) fileBytes / (1024.0 * 1024.0));
+            addMetric("bits per entry", input.nvals > 0? 8.0 * (double) fileBytes / (double) input.nvals: 0.0);
+            addMetric("ratio to csr", (double) rawBytes / (double) fileBytes);
+
+            if (format == "csrz") {
+                std::vector<uint64_t> offsets;
+                std::vector<uint32_t> cols;
+                MatrixWriter::toCsr(input, offsets, cols);
+                csrz.encode(input.nrows, input.ncols, offsets.data(), cols.data());
+                decodedBytes = sizeof(uint64_t) * offsets.size() + sizeof(uint32_t) * cols.size();
+            }
+
+#ifdef BENCH_DEBUG
+            log << ">   Write " << format << " file (outside of measured region): " << timer.getElapsedTimeMs() << " ms "
+                << fileBytes << " bytes" << std::endl;
+#endif // BENCH_DEBUG
+
+            input = Matrix{};
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            std::remove(path.c_str());
+            csrz = CompressedCsr{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Peak of the load is measured over the resident set before it
+            double vmUsage;
+            reset_peak_mem_usage();
+            process_mem_usage(vmUsage, baselineKb);
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // End to end: file (warm in page cache after setup) into coo matrix, as benchmarks load inputs
+            if (loaderKind == "coo") {
+                MatrixLoader loader(path, false);
+                loader.loadData();
+                result = std::move(loader.getMatrix());
+                return;
+            }
+
+            // End to end: file into single csr, assembled from the shards
+            ShardedLoader loader(path, false);
+            loader.loadData();
+            loader.takeCsr(offsets, cols);
+            result.nrows = loader.getNrows();
+            result.ncols = loader.getNcols();
+            result.nvals = loader.getNvals();
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            double peakMb = std::max(0.0, peak_mem_usage() - baselineKb) / 1024.0;
+            double resultBytes;
+            Fingerprint fingerprint;
+
+            if (loaderKind == "coo") {
+                fingerprint = fingerprintCoo(result.nvals, result.rows.data(), result.cols.data());
+                resultBytes = (double) (sizeof(unsigned int) * (result.rows.size() + result.cols.size()));
+            }
+            else {
+                fingerprint = fingerprintCsr(result.nrows, offsets.data(), cols.data());
+                resultBytes = (double) (sizeof(size_t) * offsets.size() + sizeof(unsigned int) * cols.size());
+            }
+
+            bool valid = fingerprint.toString() == expected.toString();
+
+            addMetric("nvals", (double) result.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+            addMetric("result MB", resultBytes / (1024.0 * 1024.0));
+            addMetric("peak MB", peakMb);
+
+            if (!valid) {
+                std::cerr << "Loaded " << format << " matrix differs: expected " << expected.toString()
+                          << " got " << fingerprint.toString() << std::endl;
+            }
+
+            // Decode of in-memory streams only, without file read and expansion into coo
+            if (format == "csrz") {
+                std::vector<uint64_t> offsets;
+                std::vector<uint32_t> cols;
+
+                Timer timer;
+                timer.start();
+                csrz.decode(offsets, cols);
+                timer.end();
+
+                double ms = timer.getElapsedTimeMs();
+                addMetric("decode ms", ms);
+                addMetric("decode GB/s", ms > 0.0? (double) decodedBytes / (ms * 1e6): 0.0);
+            }
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << result.nrows << " x " << result.ncols
+                << " nvals " << result.nvals << " fingerprint " << fingerprint.toString() << std::endl;
+#endif
+
+            result = Matrix{};
+            std::vector<size_t>().swap(offsets);
+            std::vector<unsigned int>().swap(cols);
+        }
+
+        static size_t fileSize(const std::string& path) {
+            std::ifstream file(path, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+            return file.is_open()? (size_t) file.tellg(): 0;
+        }
+
+    protected:
+
+        CompressedCsr csrz;
+        size_t decodedBytes = 0;
+        Fingerprint expected;
+
+        std::string format;
+        std::string path;
+        std::string loaderKind;
+
+        double baselineKb = 0.0;
+        std::vector<size_t> offsets;
+        std::vector<unsigned int> cols;
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+        Matrix result;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Load load(argc, argv);
+    load.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_bfs.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class MultiSourceBfs : public BenchmarkBase {
+    public:
+
+        MultiSourceBfs(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Number of bfs traversals per iteration
+            sourcesCount = std::stoull(argsProcessor.getOption("sources", "256"));
+            assert(sourcesCount > 0);
+
+            // Bits of frontier word per vertex, i.e. traversals advanced by single pass over the matrix
+            width = argsProcessor.getOption("width", "64");
+            assert(width == "64" || width == "256" || width == "512");
+
+            benchmarkName = "Native-MsBfs-" + width;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiSourceBfs() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::MirroredMatrix(native::cooToCsr(input));
+            undirected = type;
+
+            // Frontier words are gathered along in edges, transpose is not measured
+            if (!undirected)
+                A.csc();
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::MirroredMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            sources.resize(sourcesCount);
+
+            for (size_t k = 0; k < sourcesCount; k++)
+                sources[k] = traversalSource(input, iterationIdx * sourcesCount + k);
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            const auto& at = undirected ? A.csr() : A.csc();
+            Timer timer;
+            timer.start();
+
+            if (width == "64")
+                result = native::multiSourceBfs<1>(A.csr(), at, sources);
+            else if (width == "256")
+                result = native::multiSourceBfs<4>(A.csr(), at, sources);
+            else
+                result = native::multiSourceBfs<8>(A.csr(), at, sources);
+
+            timer.end();
+            traversalMs = timer.getElapsedTimeMs();
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+#ifdef BENCH_DEBUG
+            log << "   Result: sources " << sourcesCount << " reached pairs " << result.reachedPairs
+                << " traversed edges " << result.traversedEdges << " max levels " << result.levels << std::endl;
+#endif
+
+            addMetric("reached pairs", (double) result.reachedPairs);
+            addMetric("traversed edges", (double) result.traversedEdges);
+            addMetric("MTEPS", traversalMs > 0.0 ? (double) result.traversedEdges / traversalMs / 1e3 : 0.0);
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":msbfs-" + std::to_string(sourcesCount) + "-" + std::to_string(iterationIdx),
+                             std::to_string(result.reachedPairs) + ":" + std::to_string(result.traversedEdges));
+
+            result = native::MultiBfsResult{};
+        }
+
+    protected:
+
+        native::MirroredMatrix A;
+        native::MultiBfsResult result;
+        std::vector<unsigned int> sources;
+        double traversalMs = 0.0;
+        bool undirected = false;
+
+        size_t sourcesCount;
+        std::string width;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiSourceBfs bfs(argc, argv);
+    bfs.runBenchmark();
+    return 0;
+}
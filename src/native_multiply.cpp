@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Multiply : public BenchmarkBase {
+    public:
+
+        Multiply(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // AA, AAt (A x A^T) or AtA (A^T x A)
+            op = argsProcessor.getOption("op", "AA");
+            assert(op == "AA" || op == "AAt" || op == "AtA");
+
+            // cached: csc mirror is built in experiment setup, outside of measured region
+            // inline: transpose is done on each iteration, inside of measured region
+            transposeMode = argsProcessor.getOption("transpose", "cached");
+            assert(transposeMode == "cached" || transposeMode == "inline");
+
+            // full: result is materialized
+            // symbolic: only exact row sizes of the result are computed
+            // hash: only fingerprint of the result is computed on the fly, result is not stored
+            output = argsProcessor.getOption("output", "full");
+            assert(output == "full" || output == "symbolic" || output == "hash");
+
+            benchmarkName = op == "AA" ? "Native-Multiply" : "Native-Multiply-" + op + "-" + transposeMode;
+            if (output != "full")
+                benchmarkName += output == "symbolic"? "-Symbolic": "-Hash";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Multiply() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::MirroredMatrix(native::cooToCsr(input));
+
+            if (op != "AA" && transposeMode == "cached") {
+                Timer timer;
+                timer.start();
+                A.csc();
+                timer.end();
+
+#ifdef BENCH_DEBUG
+                log << ">   Transpose (outside of measured region): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::MirroredMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (transposeMode == "inline") {
+                A.dropCsc();
+            }
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (op == "AA") {
+                product(A.csr(), A.csr());
+                return;
+            }
+
+            Timer timer;
+
+            timer.start();
+            const auto& At = A.csc();
+            timer.end();
+
+            if (transposeMode == "inline") {
+                addStageSample("transpose", timer.getElapsedTimeMs());
+            }
+
+            timer.start();
+            if (op == "AAt")
+                product(A.csr(), At);
+            else
+                product(At, A.csr());
+            timer.end();
+
+            addStageSample("multiply", timer.getElapsedTimeMs());
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            size_t nvals = R.nvals();
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            auto key = ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":" + op + reorder.getKeySuffix();
+            bool valid;
+
+            // Symbolic result has no pattern, so only its size is checked
+            if (output == "symbolic") {
+                nvals = 0;
+                for (size_t i = 1; i < rowSizes.size(); i++) {
+                    nvals += rowSizes[i];
+                }
+
+                valid = references.check(key + ":nvals", std::to_string(nvals));
+            }
+            else {
+                // In hash mode fingerprint is a part of measured region, otherwise it is computed here
+                if (output == "full")
+                    fingerprint = fingerprintCsr(R.nrows, R.rowOffsets.data(), R.colIndices.data());
+
+                nvals = fingerprint.nvals;
+                valid = references.check(key + ":fingerprint", fingerprint.toString());
+            }
+
+            addMetric("nvals", (double) nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols
+                << " nvals " << nvals;
+            if (output != "symbolic")
+                log << " fingerprint " << fingerprint.toString();
+            log << std::endl;
+#endif
+
+            R = native::CsrMatrix{};
+            rowSizes.clear();
+        }
+
+        void product(const native::CsrMatrix& a, const native::CsrMatrix& b) {
+            if (output == "full")
+                R = native::multiply(a, b);
+            else if (output == "symbolic")
+                rowSizes = native::multiplySymbolic(a, b);
+            else
+                fingerprint = native::multiplyFingerprint(a, b);
+        }
+
+    protected:
+
+        native::MirroredMatrix A;
+        native::CsrMatrix R;
+
+        std::vector<size_t> rowSizes;
+        Fingerprint fingerprint;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        std::string op;
+        std::string transposeMode;
+        std::string output;
+
+        MatrixReorder reorder;
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Multiply multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class MultiplyIndex : public BenchmarkBase {
+    public:
+
+        MultiplyIndex(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // auto: narrowest index type is picked from the shape of each matrix
+            // 32: 32-bit column indices, 64: 64-bit column indices (offsets are 64-bit in both cases)
+            index = argsProcessor.getOption("index", "auto");
+            assert(index == "auto" || index == "32" || index == "64");
+
+            benchmarkName = "Native-Multiply-Index-" + index;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiplyIndex() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            // Shape is read without loading the entries, so the whole load is done in the chosen type
+            auto shape = MatrixLoader::readShape(file);
+            bits = index == "auto" ? shape.indexBits() : (unsigned int) std::stoul(index);
+
+            if (bits < shape.indexBits())
+                throw std::runtime_error("Matrix does not fit into 32-bit indices: " + file);
+
+            if (bits == 32)
+                load(file, type, A32);
+            else
+                load(file, type, A64);
+
+            addMetric("index bits", (double) bits);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            A32 = native::CsrMatrix{};
+            A64 = native::CsrMatrix64{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+
+            timer.start();
+            if (bits == 32)
+                R32 = native::multiply(A32, A32);
+            else
+                R64 = native::multiply(A64, A64);
+            timer.end();
+
+            elapsedMs = timer.getElapsedTimeMs();
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            auto key = ReferenceValues::datasetKey(entry.name, entry.isUndirected);
+
+            if (bits == 32)
+                report(key, A32, R32);
+            else
+                report(key, A64, R64);
+
+            R32 = native::CsrMatrix{};
+            R64 = native::CsrMatrix64{};
+        }
+
+        template<typename Index>
+        void load(const std::string& file, bool type, native::CsrMatrixT<Index>& a) {
+            MatrixLoaderT<Index> loader(file, type);
+            loader.loadData();
+            auto input = loader.getMatrix();
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals
+                << " index: " << bits << " bits" << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            a = native::cooToCsr(input);
+
+            // Products count of A x A: each one reads a column index of B
+            products = 0;
+            for (auto j: a.colIndices) {
+                products += a.rowOffsets[j + 1] - a.rowOffsets[j];
+            }
+        }
+
+        /**
+         * Metrics of the product: sizes of the input and the result, and estimated memory traffic per second.
+         * Traffic counts streamed A, pair of offsets and the gathered row of B per entry of A, and the written C;
+         * marker accesses are the same for any index type and are not counted.
+         */
+        template<typename Index>
+        void report(const std::string& key, const native::CsrMatrixT<Index>& a, const native::CsrMatrixT<Index>& r) {
+            auto fingerprint = fingerprintCsr(r.nrows, r.rowOffsets.data(), r.colIndices.data());
+            bool valid = references.check(key + ":AA:fingerprint", fingerprint.toString());
+
+            double traffic = (double) (a.sizeBytes() + 2 * sizeof(size_t) * a.nvals() + sizeof(Index) * products + r.sizeBytes());
+
+            addMetric("input MB", (double) a.sizeBytes() / 1e6);
+            addMetric("result MB", (double) r.sizeBytes() / 1e6);
+            addMetric("traffic GB/s", elapsedMs > 0.0 ? traffic / elapsedMs / 1e6 : 0.0);
+            addMetric("nvals", (double) fingerprint.nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << r.nrows << " x " << r.ncols
+                << " nvals " << fingerprint.nvals << " fingerprint " << fingerprint.toString() << std::endl;
+#endif
+        }
+
+    protected:
+
+        native::CsrMatrix A32;
+        native::CsrMatrix R32;
+        native::CsrMatrix64 A64;
+        native::CsrMatrix64 R64;
+
+        unsigned int bits = 32;
+        size_t products = 0;
+        double elapsedMs = 0.0;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        std::string index;
+        ArgsProcessor argsProcessor;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiplyIndex multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class MultiplyMasked : public BenchmarkBase {
+    public:
+
+        MultiplyMasked(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // structure: C<A> = A x A, complement: C<!A> = A x A
+            mask = argsProcessor.getOption("mask", "structure");
+            assert(mask == "structure" || mask == "complement");
+
+            // gustavson: masked row-wise accumulation, dot: intersection of row of A and column of A per mask entry
+            kernel = argsProcessor.getOption("kernel", "gustavson");
+            assert(kernel == "gustavson" || kernel == "dot");
+            assert(kernel != "dot" || mask == "structure");
+
+            benchmarkName = "Native-Multiply-Masked-" + mask + "-" + kernel;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiplyMasked() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::MirroredMatrix(native::cooToCsr(input));
+
+            if (kernel == "dot") {
+                Timer timer;
+                timer.start();
+                A.csc();
+                timer.end();
+
+#ifdef BENCH_DEBUG
+                log << ">   Transpose (outside of measured region): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::MirroredMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (kernel == "dot")
+                R = native::multiplyMaskedDot(A.csr(), A.csc(), A.csr());
+            else
+                R = native::multiplyMasked(A.csr(), A.csr(), A.csr(), mask == "complement");
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << R.nrows << " x " << R.ncols
+                << " nvals " << R.nvals() << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":mxm-masked-" + mask, std::to_string(R.nvals()));
+
+            R = native::CsrMatrix{};
+        }
+
+    protected:
+
+        native::MirroredMatrix A;
+        native::CsrMatrix R;
+
+        std::string mask;
+        std::string kernel;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiplyMasked multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_writer.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <omp.h>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class MultiplyPanels : public BenchmarkBase {
+    public:
+
+        MultiplyPanels(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Bytes for the whole product: input A, row sizes of C, per-thread markers and the panel of C,
+            // panel bounds are taken from the symbolic pass with what remains after the fixed part
+            budget = (size_t) (std::stod(argsProcessor.getOption("budget-mb", "1024")) * 1024.0 * 1024.0);
+            assert(budget > 0);
+
+            // file: panels are streamed into binary csr file
+            // count: only nvals of panels are accumulated
+            // hash: order independent fingerprint of panels, see Fingerprint
+            output = argsProcessor.getOption("output", "count");
+            assert(output == "file" || output == "count" || output == "hash");
+
+            path = argsProcessor.getOption("path", "Product-Panels.csr");
+
+            benchmarkName = "Native-Multiply-Panels-" + output;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiplyPanels() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::cooToCsr(input);
+            input = Matrix{};
+
+            // Fixed part is alive for the whole iteration: A, row sizes of C and per-thread markers over columns
+            fixedBytes = A.sizeBytes() + sizeof(size_t) * (A.nrows + 1) +
+                         sizeof(size_t) * A.ncols * (size_t) omp_get_max_threads();
+
+            if (fixedBytes >= budget)
+                throw std::runtime_error("Memory budget is below input, row sizes and markers of the product: " + file);
+
+#ifdef BENCH_DEBUG
+            log << ">   Budget: fixed " << (double) fixedBytes / (1024.0 * 1024.0) << " MB"
+                << " panel " << (double) (budget - fixedBytes) / (1024.0 * 1024.0) << " MB" << std::endl;
+#endif // BENCH_DEBUG
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            A = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            nvals = 0;
+            fingerprint = Fingerprint{};
+            ioBytes = 0;
+            panelBytes = 0;
+            symbolicMs = numericMs = outputMs = 0.0;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+
+            timer.start();
+            auto counts = native::multiplySymbolic(A, A);
+            auto bounds = native::panelBounds(counts, budget - fixedBytes);
+            timer.end();
+            symbolicMs = timer.getElapsedTimeMs();
+
+            panels = bounds.size() - 1;
+
+            native::CsrPanel panel;
+
+            FILE* file = nullptr;
+
+            if (output == "file") {
+                timer.start();
+                file = std::fopen(path.c_str(), "wb");
+                assert(file);
+                writeHeader(file, counts);
+                timer.end();
+                outputMs += timer.getElapsedTimeMs();
+            }
+
+            for (size_t p = 0; p < panels; p++) {
+                timer.start();
+                native::multiplyPanel(A, A, counts, bounds[p], bounds[p + 1], panel);
+                timer.end();
+                numericMs += timer.getElapsedTimeMs();
+
+                panelBytes = std::max(panelBytes, sizeof(size_t) * panel.rowOffsets.capacity() + sizeof(unsigned int) * panel.colIndices.capacity());
+
+                timer.start();
+                nvals += panel.nvals();
+
+                if (output == "file") {
+                    // Columns of all panels form the tail of the file in rows order
+                    ioBytes += sizeof(uint32_t) * std::fwrite(panel.colIndices.data(), sizeof(uint32_t), panel.colIndices.size(), file);
+                }
+                else if (output == "hash") {
+                    fingerprint.merge(panelFingerprint(panel));
+                }
+                timer.end();
+                outputMs += timer.getElapsedTimeMs();
+            }
+
+            if (file) {
+                timer.start();
+                std::fclose(file);
+                timer.end();
+                outputMs += timer.getElapsedTimeMs();
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            const double mb = 1024.0 * 1024.0;
+
+            addStageSample("symbolic", symbolicMs);
+            addStageSample("numeric", numericMs);
+            addStageSample("output", outputMs);
+
+            addMetric("panels", (double) panels);
+            addMetric("nvals", (double) nvals);
+            addMetric("panel MB", (double) panelBytes / mb);
+            addMetric("fixed MB", (double) fixedBytes / mb);
+            addMetric("nvals/s", numericMs > 0? (double) nvals / (numericMs / 1000.0): 0.0);
+
+            if (output == "file") {
+                addMetric("io MB", (double) ioBytes / mb);
+                addMetric("io MB/s", outputMs > 0? (double) ioBytes / mb / (outputMs / 1000.0): 0.0);
+            }
+
+            bool valid = true;
+
+            if (output == "hash") {
+                auto& entry = argsProcessor.getEntries()[experimentIdx];
+                valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":AA:fingerprint", fingerprint.toString());
+                addMetric("verified", valid ? 1.0 : 0.0);
+            }
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << A.nrows << " x " << A.ncols << " nvals " << nvals
+                << " panels " << panels << " panel " << (double) panelBytes / mb << " MB";
+            if (output == "file")
+                log << " written " << (double) ioBytes / mb << " MB to " << path;
+            if (output == "hash")
+                log << " fingerprint " << fingerprint.toString() << (valid? "": " MISMATCH");
+            log << std::endl;
+#endif
+        }
+
+        /** Header and row offsets of binary csr (see MatrixWriter::saveCsr), offsets are known from symbolic pass */
+        void writeHeader(FILE* file, const std::vector<size_t>& counts) {
+            uint64_t header[3] = { A.nrows, A.ncols, 0 };
+            for (size_t i = 0; i < A.nrows; i++) {
+                header[2] += counts[i + 1];
+            }
+
+            std::fwrite(MatrixWriter::csrMagic(), 1, 8, file);
+            std::fwrite(header, sizeof(uint64_t), 3, file);
+            ioBytes += 8 + sizeof(header);
+
+            const size_t block = 1 << 16;
+            std::vector<uint64_t> offsets;
+            offsets.reserve(block);
+
+            uint64_t offset = 0;
+            for (size_t i = 0; i <= A.nrows; i++) {
+                offsets.push_back(offset);
+                offset += i < A.nrows? counts[i + 1]: 0;
+
+                if (offsets.size() == block || i == A.nrows) {
+                    ioBytes += sizeof(uint64_t) * std::fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file);
+                    offsets.clear();
+                }
+            }
+        }
+
+        static Fingerprint panelFingerprint(const native::CsrPanel& panel) {
+            uint64_t hash = 0;
+
+#pragma omp parallel for schedule(dynamic, 256) reduction(+: hash)
+            for (size_t i = panel.firstRow; i < panel.lastRow; i++) {
+                auto local = i - panel.firstRow;
+                for (size_t k = panel.rowOffsets[local]; k < panel.rowOffsets[local + 1]; k++) {
+                    hash += entryHash(i, panel.colIndices[k]);
+                }
+            }
+
+            Fingerprint fingerprint;
+            fingerprint.nvals = panel.nvals();
+            fingerprint.hash = hash;
+            return fingerprint;
+        }
+
+    protected:
+
+        native::CsrMatrix A;
+
+        size_t budget;
+        size_t fixedBytes = 0;
+        std::string output;
+        std::string path;
+
+        size_t panels = 0;
+        size_t nvals = 0;
+        Fingerprint fingerprint;
+        size_t ioBytes = 0;
+        size_t panelBytes = 0;
+        double symbolicMs = 0.0;
+        double numericMs = 0.0;
+        double outputMs = 0.0;
+
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiplyPanels multiplyPanels(argc, argv);
+    multiplyPanels.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_ewise.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class PowerChain : public BenchmarkBase {
+    public:
+
+        PowerChain(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // power: A^k, sum: A + A^2 + ... + A^k (k-hop neighborhood)
+            result = argsProcessor.getOption("result", "sum");
+            assert(result == "power" || result == "sum");
+
+            // chain: P = P x A step by step
+            // squaring: binary powering, sum is doubled as S = S + P x S
+            // frontier: only new pairs are expanded F = (F x A) \ S, sum only
+            mode = argsProcessor.getOption("mode", "chain");
+            assert(mode == "chain" || mode == "squaring" || mode == "frontier");
+            assert(mode != "frontier" || result == "sum");
+
+            power = std::stoull(argsProcessor.getOption("power", "3"));
+            assert(power >= 1);
+
+            // Stop (not completed) if intermediate result grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+
+            benchmarkName = "Native-PowerChain-" + result + "-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~PowerChain() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Step {
+            std::string op;
+            size_t power;
+            size_t nvals;
+            size_t sumNvals;
+            double mxmMs;
+            double addMs;
+        };
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::cooToCsr(input);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            steps.clear();
+            completed = true;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            bool sum = result == "sum";
+
+            // P = A^m, S = A + ... + A^m
+            P = A;
+            S = sum ? A : native::CsrMatrix{};
+
+            if (mode == "chain") {
+                for (size_t m = 2; m <= power && !stop(); m++) {
+                    Step step{"chain", m};
+                    P = timed(step.mxmMs, [&]() { return native::multiply(P, A); });
+                    if (sum)
+                        S = timed(step.addMs, [&]() { return native::add(S, P); });
+                    pushStep(step);
+                }
+            }
+            else if (mode == "frontier") {
+                // P is a frontier: pairs, which are reachable in exactly m hops and not less
+                for (size_t m = 2; m <= power && !stop() && P.nvals() > 0; m++) {
+                    Step step{"frontier", m};
+                    P = timed(step.mxmMs, [&]() { return native::multiplyMasked(P, A, S, true); });
+                    S = timed(step.addMs, [&]() { return native::add(S, P); });
+                    pushStep(step);
+                }
+            }
+            else {
+                size_t bit = highestBit(power);
+                size_t m = 1;
+
+                while (bit > 1 && !stop()) {
+                    bit >>= 1;
+                    bool increment = (power & bit) != 0;
+                    bool last = bit == 1 && !increment;
+
+                    // Double: S = S + P x S, P = P x P, last power is not needed for the sum
+                    Step doubling{"square", 2 * m};
+                    if (sum) {
+                        auto Q = timed(doubling.mxmMs, [&]() { return native::multiply(P, S); });
+                        S = timed(doubling.addMs, [&]() { return native::add(S, Q); });
+                    }
+                    if (!sum || !last) {
+                        double ms = 0.0;
+                        P = timed(ms, [&]() { return native::multiply(P, P); });
+                        doubling.mxmMs += ms;
+                    }
+                    m *= 2;
+                    pushStep(doubling);
+
+                    // Increment: P = P x A, S = S + P
+                    if (increment && !stop()) {
+                        Step step{"chain", m + 1};
+                        P = timed(step.mxmMs, [&]() { return native::multiply(P, A); });
+                        if (sum)
+                            S = timed(step.addMs, [&]() { return native::add(S, P); });
+                        m += 1;
+                        pushStep(step);
+                    }
+                }
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Step total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.mxmMs += step.mxmMs;
+                total.addMs += step.addMs;
+
+#ifdef BENCH_DEBUG
+                log << "   step " << i << " (" << step.op << "): power " << step.power << " nvals " << step.nvals;
+                if (result == "sum")
+                    log << " sum nvals " << step.sumNvals;
+                log << " mxm " << step.mxmMs << " ms add " << step.addMs << " ms" << std::endl;
+#endif
+            }
+
+            size_t nvals = result == "sum" ? S.nvals() : P.nvals();
+            double n = (double) input.nrows;
+
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("add", total.addMs);
+
+            addMetric("steps", (double) steps.size());
+            addMetric("nvals", (double) nvals);
+            addMetric("growth", input.nvals > 0 ? (double) nvals / (double) input.nvals : 0.0);
+            addMetric("density", n > 0 ? (double) nvals / (n * n) : 0.0);
+            addMetric("completed", completed ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols
+                << " nvals " << nvals << " steps " << steps.size() << " completed " << completed << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            if (completed)
+                references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":" + result + "-" + std::to_string(power), std::to_string(nvals));
+
+            P = native::CsrMatrix{};
+            S = native::CsrMatrix{};
+        }
+
+        template<typename F>
+        native::CsrMatrix timed(double& ms, F&& f) {
+            Timer timer;
+            timer.start();
+            auto r = f();
+            timer.end();
+            ms = timer.getElapsedTimeMs();
+            return r;
+        }
+
+        void pushStep(Step& step) {
+            step.nvals = P.nvals();
+            step.sumNvals = S.nvals();
+            steps.push_back(step);
+        }
+
+        static size_t highestBit(size_t x) {
+            size_t bit = 1;
+            while (bit <= x / 2)
+                bit <<= 1;
+            return bit;
+        }
+
+        bool stop() {
+            completed = completed && !(maxNvals > 0 && std::max(P.nvals(), S.nvals()) > maxNvals);
+            return !completed;
+        }
+
+    protected:
+
+        native::CsrMatrix A;
+        native::CsrMatrix P;
+        native::CsrMatrix S;
+
+        std::string result;
+        std::string mode;
+        size_t power;
+        size_t maxNvals;
+
+        std::vector<Step> steps;
+        bool completed = true;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::PowerChain powerChain(argc, argv);
+    powerChain.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_profile.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Profile : public BenchmarkBase {
+    public:
+
+        Profile(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Size of the diagonal blocks for locality estimation
+            blockSize = std::stoull(argsProcessor.getOption("block", "1024"));
+            assert(blockSize > 0);
+
+            benchmarkName = "Native-Profile";
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Profile() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            assert(input.nrows == input.ncols);
+
+            A = native::cooToCsr(input);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            A = native::CsrMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+
+            timer.start();
+            flops = native::multiplyFlops(A, A);
+            timer.end();
+            flopsMs = timer.getElapsedTimeMs();
+
+            // Exact nnz(A x A) by symbolic pass only, C is never stored
+            timer.start();
+            squareOffsets = native::multiplySymbolic(A, A);
+            for (size_t i = 0; i < A.nrows; i++) {
+                squareOffsets[i + 1] += squareOffsets[i];
+            }
+            timer.end();
+            symbolicMs = timer.getElapsedTimeMs();
+
+            timer.start();
+            rowsHistogram = native::rowsHistogram(A.rowOffsets);
+            squareRowsHistogram = native::rowsHistogram(squareOffsets);
+            band = native::bandProfile(A, blockSize);
+            timer.end();
+            structureMs = timer.getElapsedTimeMs();
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            size_t squareNvals = squareOffsets[A.nrows];
+            double compression = squareNvals > 0? (double) flops / (double) squareNvals: 0.0;
+            double diagonalShare = A.nvals() > 0? (double) band.diagonalBlocksNvals / (double) A.nvals(): 0.0;
+            double diagonalDensity = band.diagonalBlocksArea > 0? (double) band.diagonalBlocksNvals / band.diagonalBlocksArea: 0.0;
+
+            addStageSample("flops", flopsMs);
+            addStageSample("symbolic", symbolicMs);
+            addStageSample("structure", structureMs);
+
+            addMetric("nvals", (double) A.nvals());
+            addMetric("flops", (double) flops);
+            addMetric("square nvals", (double) squareNvals);
+            addMetric("compression", compression);
+            addMetric("bandwidth", (double) band.bandwidth);
+            addMetric("mean distance", band.meanDistance);
+            addMetric("profile", (double) band.profile);
+            addMetric("diagonal block share", diagonalShare);
+            addMetric("diagonal block density", diagonalDensity);
+
+            for (size_t b = 0; b < rowsHistogram.size(); b++) {
+                addMetric("rows " + native::rowsBucketName(b), (double) rowsHistogram[b]);
+            }
+            for (size_t b = 0; b < squareRowsHistogram.size(); b++) {
+                addMetric("square rows " + native::rowsBucketName(b), (double) squareRowsHistogram[b]);
+            }
+
+#ifdef BENCH_DEBUG
+            log << "   Profile: flops " << flops << " nnz(A^2) " << squareNvals << " compression " << compression << std::endl
+                << "            bandwidth " << band.bandwidth << " mean distance " << band.meanDistance << " profile " << band.profile << std::endl
+                << "            diagonal blocks " << blockSize << ": share " << diagonalShare << " density " << diagonalDensity << std::endl;
+#endif
+
+            squareOffsets.clear();
+        }
+
+    protected:
+
+        native::CsrMatrix A;
+        size_t blockSize;
+
+        size_t flops = 0;
+        std::vector<size_t> squareOffsets;
+        std::vector<size_t> rowsHistogram;
+        std::vector<size_t> squareRowsHistogram;
+        native::BandProfile band;
+
+        double flopsMs = 0.0;
+        double symbolicMs = 0.0;
+        double structureMs = 0.0;
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Profile profile(argc, argv);
+    profile.runBenchmark();
+    return 0;
+}
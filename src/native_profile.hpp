@@ -0,0 +1,167 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_PROFILE_HPP
+#define SPBENCH_NATIVE_PROFILE_HPP
+
+#include <vector>
+#include <string>
+#include <cassert>
+#include <algorithm>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+
+        /** Layout of the entries relative to the main diagonal */
+        struct BandProfile {
+            size_t bandwidth = 0;           // max |i - j|
+            double meanDistance = 0.0;      // mean |i - j| over entries
+            size_t profile = 0;             // sum over rows of i - min j for entries left of the diagonal
+            size_t blockSize = 0;
+            size_t diagonalBlocksNvals = 0; // entries (i, j) with i / blockSize == j / blockSize
+            double diagonalBlocksArea = 0.0;
+        };
+
+        /** @return Number of multiplications in boolean A x B, sum over entries (i, k) of A of size of row k of B */
+        inline size_t multiplyFlops(const CsrMatrix& a, const CsrMatrix& b) {
+            assert(a.ncols == b.nrows);
+
+            size_t flops = 0;
+
+#pragma omp parallel for schedule(dynamic, 256) reduction(+: flops)
+            for (size_t i = 0; i < a.nrows; i++) {
+                for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                    auto j = a.colIndices[k];
+                    flops += b.rowOffsets[j + 1] - b.rowOffsets[j];
+                }
+            }
+
+            return flops;
+        }
+
+        /**
+         * Histogram of row sizes in power of two buckets: bucket 0 counts empty rows,
+         * bucket b > 0 counts rows with size in [2^(b-1), 2^b).
+         * @param rowOffsets Prefix sums of row sizes, nrows + 1 entries
+         */
+        inline std::vector<size_t> rowsHistogram(const std::vector<size_t>& rowOffsets) {
+            const size_t buckets = 8 * sizeof(size_t) + 1;
+            std::vector<size_t> histogram(buckets, 0);
+            size_t nrows = rowOffsets.size() - 1;
+
+#pragma omp parallel
+            {
+                std::vector<size_t> local(buckets, 0);
+
+#pragma omp for schedule(static)
+                for (size_t i = 0; i < nrows; i++) {
+                    size_t size = rowOffsets[i + 1] - rowOffsets[i];
+                    size_t bucket = 0;
+
+                    while (size > 0) {
+                        size >>= 1;
+                        bucket += 1;
+                    }
+
+                    local[bucket] += 1;
+                }
+
+#pragma omp critical
+                for (size_t b = 0; b < buckets; b++) {
+                    histogram[b] += local[b];
+                }
+            }
+
+            while (histogram.size() > 1 && histogram.back() == 0) {
+                histogram.pop_back();
+            }
+
+            return histogram;
+        }
+
+        /** @return Readable name of the histogram bucket, as in rowsHistogram */
+        inline std::string rowsBucketName(size_t bucket) {
+            if (bucket == 0)
+                return "0";
+            if (bucket == 1)
+                return "1";
+
+            size_t first = (size_t) 1 << (bucket - 1);
+            return std::to_string(first) + "-" + std::to_string(2 * first - 1);
+        }
+
+        /** @return Bandwidth, profile and share of the entries inside diagonal blocks of size blockSize */
+        inline BandProfile bandProfile(const CsrMatrix& a, size_t blockSize) {
+            assert(blockSize > 0);
+
+            BandProfile band;
+            band.blockSize = blockSize;
+
+            size_t bandwidth = 0;
+            size_t profile = 0;
+            size_t diagonalNvals = 0;
+            double distance = 0.0;
+
+#pragma omp parallel for schedule(dynamic, 256) reduction(max: bandwidth) reduction(+: profile, diagonalNvals, distance)
+            for (size_t i = 0; i < a.nrows; i++) {
+                auto first = a.rowOffsets[i];
+                auto last = a.rowOffsets[i + 1];
+
+                if (first == last)
+                    continue;
+
+                // Columns are sorted, so the farthest entries are the first and the last ones
+                size_t left = a.colIndices[first];
+                size_t right = a.colIndices[last - 1];
+
+                bandwidth = std::max(bandwidth, std::max(i > left? i - left: left - i, i > right? i - right: right - i));
+                profile += i > left? i - left: 0;
+
+                for (size_t k = first; k < last; k++) {
+                    size_t j = a.colIndices[k];
+                    distance += (double) (i > j? i - j: j - i);
+                    diagonalNvals += i / blockSize == j / blockSize? 1: 0;
+                }
+            }
+
+            // Area of the diagonal blocks, the last ones may be clipped by the matrix shape
+            double area = 0.0;
+            for (size_t first = 0; first < std::min(a.nrows, a.ncols); first += blockSize) {
+                area += (double) std::min(blockSize, a.nrows - first) * (double) std::min(blockSize, a.ncols - first);
+            }
+
+            band.bandwidth = bandwidth;
+            band.profile = profile;
+            band.meanDistance = a.nvals() > 0? distance / (double) a.nvals(): 0.0;
+            band.diagonalBlocksNvals = diagonalNvals;
+            band.diagonalBlocksArea = area;
+
+            return band;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_PROFILE_HPP
@@ -0,0 +1,287 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <labeled_graph_loader.hpp>
+#include <automaton.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spgemm.hpp>
+#include <native_ewise.hpp>
+#include <native_kronecker.hpp>
+
+#include <unordered_map>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class Rpq : public BenchmarkBase {
+    public:
+
+        Rpq(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            automaton = Automaton(getAutomatonPath());
+
+            // materialized: K = sum of Aut[x] (x) G[x] is built, reachability is computed on K
+            // streaming: blocks Aut[x][q, q'] * G[x] of K are applied to the frontier, K is never built
+            kroneckerMode = argsProcessor.getOption("kronecker", "streaming");
+            assert(kroneckerMode == "streaming" || kroneckerMode == "materialized");
+
+            // Stop (not converged) if reachable set grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+
+            benchmarkName = "Native-RPQ-" + getAutomatonName() + "-" + kroneckerMode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Rpq() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        std::string getAutomatonPath() const {
+            return argsProcessor.getOption("automaton", "data/automata/a_plus.txt");
+        }
+
+        std::string getAutomatonName() const {
+            auto path = getAutomatonPath();
+            auto name = path.substr(path.find_last_of('/') + 1);
+            return name.substr(0, name.find_last_of('.'));
+        }
+
+        void setupBenchmark() override {
+            automaton.loadData();
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            LabeledGraphLoader loader(file, type);
+            loader.loadData();
+
+            n = loader.getVerticesCount();
+
+            for (auto& label: loader.getLabels()) {
+                labels[label.name] = native::cooToCsr(label.matrix);
+
+#ifdef BENCH_DEBUG
+                log << ">   Load label: \"" << label.name << "\" of \"" << file << "\" isUndirected: " << type << std::endl
+                    << "                 size: " << n << " x " << n << " nvals: " << label.matrix.nvals << std::endl;
+#endif // BENCH_DEBUG
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            labels.clear();
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            iterations = 0;
+            kroneckerNvals = 0;
+            converged = false;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            if (kroneckerMode == "materialized")
+                execMaterialized();
+            else
+                execStreaming();
+        }
+
+        void execMaterialized() {
+            const size_t k = automaton.getStatesCount();
+            Timer timer;
+
+            timer.start();
+            auto K = native::emptyCsr(k * n, k * n);
+
+            for (auto& label: labels) {
+                Matrix transitions;
+                transitions.nrows = k;
+                transitions.ncols = k;
+
+                for (auto& t: automaton.getTransitions()) {
+                    if (t.label == label.first) {
+                        transitions.rows.push_back((unsigned int) t.from);
+                        transitions.cols.push_back((unsigned int) t.to);
+                    }
+                }
+
+                transitions.nvals = transitions.rows.size();
+
+                if (transitions.nvals > 0)
+                    K = native::add(K, native::kronecker(native::cooToCsr(transitions), label.second));
+            }
+
+            kroneckerNvals = K.nvals();
+            timer.end();
+            addStageSample("kronecker", timer.getElapsedTimeMs());
+
+            // Frontier and reachable set are n x kn: row v is the set of (state, vertex) reachable from (start, v)
+            timer.start();
+            auto F = native::emptyCsr(n, k * n);
+            F.colIndices.resize(n);
+
+            for (size_t v = 0; v < n; v++) {
+                F.rowOffsets[v + 1] = v + 1;
+                F.colIndices[v] = (unsigned int) (automaton.getStart() * n + v);
+            }
+
+            auto R = F;
+
+            while (F.nvals() > 0 && !(maxNvals > 0 && R.nvals() > maxNvals)) {
+                F = native::subtract(native::multiply(F, K), R);
+                R = native::add(R, F);
+                iterations += 1;
+            }
+
+            converged = F.nvals() == 0;
+            timer.end();
+            addStageSample("reachability", timer.getElapsedTimeMs());
+
+            timer.start();
+            result = native::emptyCsr(n, n);
+
+            for (auto f: automaton.getFinals()) {
+                result = native::add(result, native::columnsBlock(R, f * n, n));
+            }
+
+            timer.end();
+            addStageSample("extract", timer.getElapsedTimeMs());
+        }
+
+        void execStreaming() {
+            const size_t k = automaton.getStatesCount();
+            Timer timer;
+
+            // Per state frontier and reachable set: F[q] row v is the set of vertices u, such that (q, u) is reachable from (start, v)
+            timer.start();
+            std::vector<native::CsrMatrix> F(k, native::emptyCsr(n, n));
+            std::vector<native::CsrMatrix> R(k, native::emptyCsr(n, n));
+
+            F[automaton.getStart()] = native::identityCsr(n);
+            R[automaton.getStart()] = native::identityCsr(n);
+
+            auto frontierNvals = [&]() {
+                size_t total = 0;
+                for (auto& f: F) total += f.nvals();
+                return total;
+            };
+
+            auto reachableNvals = [&]() {
+                size_t total = 0;
+                for (auto& r: R) total += r.nvals();
+                return total;
+            };
+
+            while (frontierNvals() > 0 && !(maxNvals > 0 && reachableNvals() > maxNvals)) {
+                std::vector<native::CsrMatrix> P(k, native::emptyCsr(n, n));
+
+                for (auto& t: automaton.getTransitions()) {
+                    auto label = labels.find(t.label);
+
+                    if (label == labels.end() || F[t.from].nvals() == 0)
+                        continue;
+
+                    P[t.to] = native::add(P[t.to], native::multiply(F[t.from], label->second));
+                }
+
+                for (size_t q = 0; q < k; q++) {
+                    F[q] = native::subtract(P[q], R[q]);
+                    R[q] = native::add(R[q], F[q]);
+                }
+
+                iterations += 1;
+            }
+
+            converged = frontierNvals() == 0;
+            timer.end();
+            addStageSample("reachability", timer.getElapsedTimeMs());
+
+            timer.start();
+            result = native::emptyCsr(n, n);
+
+            for (auto f: automaton.getFinals()) {
+                result = native::add(result, R[f]);
+            }
+
+            timer.end();
+            addStageSample("extract", timer.getElapsedTimeMs());
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            addMetric("iterations", (double) iterations);
+            addMetric("pairs", (double) result.nvals());
+            addMetric("converged", converged ? 1.0 : 0.0);
+
+            if (kroneckerMode == "materialized")
+                addMetric("kronecker nvals", (double) kroneckerNvals);
+
+#ifdef BENCH_DEBUG
+            log << "   Result: reachable pairs " << result.nvals() << " iterations " << iterations
+                << " converged " << converged << std::endl;
+#endif
+
+            result = native::CsrMatrix{};
+        }
+
+    protected:
+
+        ArgsProcessor argsProcessor;
+        Automaton automaton;
+        std::string kroneckerMode;
+
+        size_t n = 0;
+        std::unordered_map<std::string, native::CsrMatrix> labels;
+        native::CsrMatrix result;
+
+        size_t maxNvals;
+        size_t iterations = 0;
+        size_t kroneckerNvals = 0;
+        bool converged = false;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Rpq rpq(argc, argv);
+    rpq.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_RUNS_HPP
+#define SPBENCH_NATIVE_RUNS_HPP
+
+#include <vector>
+#include <numeric>
+#include <native_csr.hpp>
+#include <native_ewise.hpp>
+
+namespace benchmark {
+    namespace native {
+
+        /**
+         * Boolean matrix stored as sum of sorted runs (log-structured merge).
+         * Update is appended as new run, the newest runs are merged while older run is not much larger,
+         * so each value is rewritten O(log(updates)) times instead of on each update.
+         */
+        class RunMatrix {
+        public:
+            RunMatrix() = default;
+
+            explicit RunMatrix(CsrMatrix base) {
+                runs.push_back(std::move(base));
+            }
+
+            void append(CsrMatrix run) {
+                if (run.nvals() == 0)
+                    return;
+
+                runs.push_back(std::move(run));
+
+                while (runs.size() > 1 && runs[runs.size() - 2].nvals() <= MERGE_RATIO * runs.back().nvals())
+                    mergeLast();
+            }
+
+            /** Merges all runs into the single one */
+            const CsrMatrix& compact() {
+                assert(!runs.empty());
+
+                while (runs.size() > 1)
+                    mergeLast();
+
+                return runs.front();
+            }
+
+            size_t runsCount() const {
+                return runs.size();
+            }
+
+            /** @return Sum of runs sizes, values may be duplicated among runs */
+            size_t storedNvals() const {
+                return std::accumulate(runs.begin(), runs.end(), (size_t) 0, [](size_t s, const CsrMatrix& r) {
+                    return s + r.nvals();
+                });
+            }
+
+        private:
+
+            static const size_t MERGE_RATIO = 2;
+
+            void mergeLast() {
+                auto last = std::move(runs.back());
+                runs.pop_back();
+                runs.back() = add(runs.back(), last);
+            }
+
+            std::vector<CsrMatrix> runs;
+        };
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_RUNS_HPP
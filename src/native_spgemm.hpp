@@ -0,0 +1,460 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_SPGEMM_HPP
+#define SPBENCH_NATIVE_SPGEMM_HPP
+
+#include <vector>
+#include <cassert>
+#include <algorithm>
+#include <matrix_utils.hpp>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+
+        /**
+         * Symbolic pass of boolean C = A x B: exact number of entries in each row of C,
+         * counted with per-thread marker without materializing C.
+         * @return Row sizes of C, nrows + 1 entries, entry i + 1 is the size of row i
+         */
+        template<typename Index>
+        inline std::vector<size_t> multiplySymbolic(const CsrMatrixT<Index>& a, const CsrMatrixT<Index>& b) {
+            assert(a.ncols == b.nrows);
+
+            const size_t unmarked = (size_t) -1;
+
+            std::vector<size_t> counts(a.nrows + 1, 0);
+
+#pragma omp parallel
+            {
+                std::vector<size_t> marker(b.ncols, unmarked);
+
+#pragma omp for schedule(dynamic, 64)
+                for (size_t i = 0; i < a.nrows; i++) {
+                    size_t count = 0;
+
+                    for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                        auto j = a.colIndices[k];
+
+                        for (size_t l = b.rowOffsets[j]; l < b.rowOffsets[j + 1]; l++) {
+                            auto col = b.colIndices[l];
+
+                            if (marker[col] != i) {
+                                marker[col] = i;
+                                count += 1;
+                            }
+                        }
+                    }
+
+                    counts[i + 1] = count;
+                }
+            }
+
+            return counts;
+        }
+
+        /**
+         * Fingerprint of boolean C = A x B (see Fingerprint), computed on the fly by the symbolic pass:
+         * each entry is hashed, when it is marked for the first time in its row, C is never stored.
+         */
+        template<typename Index>
+        inline Fingerprint multiplyFingerprint(const CsrMatrixT<Index>& a, const CsrMatrixT<Index>& b) {
+            assert(a.ncols == b.nrows);
+
+            const size_t unmarked = (size_t) -1;
+
+            size_t nvals = 0;
+            uint64_t hash = 0;
+
+#pragma omp parallel reduction(+: nvals, hash)
+            {
+                std::vector<size_t> marker(b.ncols, unmarked);
+
+#pragma omp for schedule(dynamic, 64)
+                for (size_t i = 0; i < a.nrows; i++) {
+                    for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                        auto j = a.colIndices[k];
+
+                        for (size_t l = b.rowOffsets[j]; l < b.rowOffsets[j + 1]; l++) {
+                            auto col = b.colIndices[l];
+
+                            if (marker[col] != i) {
+                                marker[col] = i;
+                                nvals += 1;
+                                hash += entryHash(i, col);
+                            }
+                        }
+                    }
+                }
+            }
+
+            Fingerprint fingerprint;
+            fingerprint.nvals = nvals;
+            fingerprint.hash = hash;
+            return fingerprint;
+        }
+
+        /**
+         * Numeric pass of boolean C = A x B for rows [firstRow, lastRow).
+         * @param offsets Prefix sums of the sizes of the rows, offsets[0] is the position of firstRow in colIndices
+         * @param colIndices Storage for the columns of the rows, filled and sorted within rows
+         */
+        template<typename Index>
+        inline void multiplyNumeric(const CsrMatrixT<Index>& a, const CsrMatrixT<Index>& b, size_t firstRow, size_t lastRow,
+                                    const std::vector<size_t>& offsets, std::vector<Index>& colIndices) {
+            assert(a.ncols == b.nrows);
+            assert(lastRow <= a.nrows);
+
+            const size_t unmarked = (size_t) -1;
+
+#pragma omp parallel
+            {
+                std::vector<size_t> marker(b.ncols, unmarked);
+
+#pragma omp for schedule(dynamic, 64)
+                for (size_t i = firstRow; i < lastRow; i++) {
+                    auto first = offsets[i - firstRow];
+                    auto pos = first;
+
+                    for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                        auto j = a.colIndices[k];
+
+                        for (size_t l = b.rowOffsets[j]; l < b.rowOffsets[j + 1]; l++) {
+                            auto col = b.colIndices[l];
+
+                            if (marker[col] != i) {
+                                marker[col] = i;
+                                colIndices[pos++] = col;
+                            }
+                        }
+                    }
+
+                    std::sort(colIndices.begin() + first, colIndices.begin() + pos);
+                }
+            }
+        }
+
+        /**
+         * Boolean C = A x B, row-parallel Gustavson.
+         * Symbolic pass counts row sizes with per-thread marker, numeric pass fills and sorts rows.
+         */
+        template<typename Index>
+        inline CsrMatrixT<Index> multiply(const CsrMatrixT<Index>& a, const CsrMatrixT<Index>& b) {
+            assert(a.ncols == b.nrows);
+
+            CsrMatrixT<Index> c;
+            c.nrows = a.nrows;
+            c.ncols = b.ncols;
+            c.rowOffsets = multiplySymbolic(a, b);
+
+            for (size_t i = 0; i < c.nrows; i++) {
+                c.rowOffsets[i + 1] += c.rowOffsets[i];
+            }
+
+            c.colIndices.resize(c.rowOffsets[c.nrows]);
+            multiplyNumeric(a, b, 0, a.nrows, c.rowOffsets, c.colIndices);
+
+            return c;
+        }
+
+        /** Rows [firstRow, lastRow) of the product, offsets are local to the panel */
+        struct CsrPanel {
+            size_t firstRow = 0;
+            size_t lastRow = 0;
+            std::vector<size_t> rowOffsets;
+            std::vector<unsigned int> colIndices;
+
+            size_t nvals() const {
+                return rowOffsets.empty()? 0: rowOffsets.back();
+            }
+        };
+
+        /**
+         * Splits the rows of C into panels, so each panel (offsets and columns) fits into budget bytes.
+         * Row, which exceeds the budget on its own, forms a separate panel.
+         * @param counts Row sizes of C from multiplySymbolic
+         * @return Panel bounds: panel p is rows [bounds[p], bounds[p + 1])
+         */
+        inline std::vector<size_t> panelBounds(const std::vector<size_t>& counts, size_t budget) {
+            size_t nrows = counts.size() - 1;
+            std::vector<size_t> bounds(1, 0);
+            size_t bytes = sizeof(size_t);
+
+            for (size_t i = 0; i < nrows; i++) {
+                size_t rowBytes = sizeof(size_t) + sizeof(unsigned int) * counts[i + 1];
+
+                if (bytes + rowBytes > budget && i > bounds.back()) {
+                    bounds.push_back(i);
+                    bytes = sizeof(size_t);
+                }
+
+                bytes += rowBytes;
+            }
+
+            bounds.push_back(nrows);
+            return bounds;
+        }
+
+        /**
+         * Computes panel of C = A x B into the panel storage, which is replaced on each call.
+         * @param counts Row sizes of C from multiplySymbolic
+         */
+        inline void multiplyPanel(const CsrMatrix& a, const CsrMatrix& b, const std::vector<size_t>& counts,
+                                  size_t firstRow, size_t lastRow, CsrPanel& panel) {
+            size_t rows = lastRow - firstRow;
+            size_t nvals = 0;
+
+            for (size_t i = firstRow; i < lastRow; i++) {
+                nvals += counts[i + 1];
+            }
+
+            // Storage of the previous panel is released first and the new one is allocated exactly,
+            // so memory never exceeds the size of one panel
+            std::vector<size_t>().swap(panel.rowOffsets);
+            std::vector<unsigned int>().swap(panel.colIndices);
+            panel.rowOffsets.reserve(rows + 1);
+            panel.colIndices.reserve(nvals);
+
+            panel.firstRow = firstRow;
+            panel.lastRow = lastRow;
+            panel.rowOffsets.resize(rows + 1);
+            panel.rowOffsets[0] = 0;
+
+            for (size_t i = firstRow; i < lastRow; i++) {
+                panel.rowOffsets[i - firstRow + 1] = panel.rowOffsets[i - firstRow] + counts[i + 1];
+            }
+
+            panel.colIndices.resize(nvals);
+            multiplyNumeric(a, b, firstRow, lastRow, panel.rowOffsets, panel.colIndices);
+        }
+
+        namespace details {
+
+            /** Size of intersection of sorted ranges, binary search is used if one range is much shorter */
+            template<typename It>
+            size_t intersectionSize(It aFirst, It aLast, It bFirst, It bLast) {
+                size_t aSize = aLast - aFirst;
+                size_t bSize = bLast - bFirst;
+
+                if (aSize > bSize) {
+                    std::swap(aFirst, bFirst);
+                    std::swap(aLast, bLast);
+                    std::swap(aSize, bSize);
+                }
+
+                size_t count = 0;
+
+                if (aSize * 32 < bSize) {
+                    for (auto it = aFirst; it != aLast; ++it) {
+                        bFirst = std::lower_bound(bFirst, bLast, *it);
+                        if (bFirst == bLast)
+                            break;
+                        if (*bFirst == *it)
+                            count += 1;
+                    }
+
+                    return count;
+                }
+
+                while (aFirst != aLast && bFirst != bLast) {
+                    if (*aFirst < *bFirst)
+                        ++aFirst;
+                    else if (*bFirst < *aFirst)
+                        ++bFirst;
+                    else {
+                        count += 1;
+                        ++aFirst;
+                        ++bFirst;
+                    }
+                }
+
+                return count;
+            }
+
+        }
+
+        /**
+         * Boolean C<M> = A x B (or C<!M> = A x B if complement), masked Gustavson.
+         * Columns of the mask row are marked first, so only allowed (or not forbidden) entries are accumulated.
+         */
+        inline CsrMatrix multiplyMasked(const CsrMatrix& a, const CsrMatrix& b, const CsrMatrix& mask, bool complement) {
+            assert(a.ncols == b.nrows);
+            assert(mask.nrows == a.nrows);
+            assert(mask.ncols == b.ncols);
+
+            const size_t unmarked = (size_t) -1;
+
+            CsrMatrix c;
+            c.nrows = a.nrows;
+            c.ncols = b.ncols;
+            c.rowOffsets.assign(a.nrows + 1, 0);
+
+            // Phase 0 counts row sizes, phase 1 fills rows
+            for (int phase = 0; phase < 2; phase++) {
+                if (phase == 1) {
+                    for (size_t i = 0; i < c.nrows; i++) {
+                        c.rowOffsets[i + 1] += c.rowOffsets[i];
+                    }
+
+                    c.colIndices.resize(c.rowOffsets[c.nrows]);
+                }
+
+#pragma omp parallel
+                {
+                    std::vector<size_t> masked(b.ncols, unmarked);
+                    std::vector<size_t> marker(b.ncols, unmarked);
+
+#pragma omp for schedule(dynamic, 64)
+                    for (size_t i = 0; i < a.nrows; i++) {
+                        if (!complement && mask.rowOffsets[i] == mask.rowOffsets[i + 1])
+                            continue;
+
+                        for (size_t k = mask.rowOffsets[i]; k < mask.rowOffsets[i + 1]; k++) {
+                            masked[mask.colIndices[k]] = i;
+                        }
+
+                        size_t first = phase == 1 ? c.rowOffsets[i] : 0;
+                        size_t pos = first;
+
+                        for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                            auto j = a.colIndices[k];
+
+                            for (size_t l = b.rowOffsets[j]; l < b.rowOffsets[j + 1]; l++) {
+                                auto col = b.colIndices[l];
+
+                                if ((masked[col] == i) != complement && marker[col] != i) {
+                                    marker[col] = i;
+                                    if (phase == 1)
+                                        c.colIndices[pos] = col;
+                                    pos += 1;
+                                }
+                            }
+                        }
+
+                        if (phase == 0)
+                            c.rowOffsets[i + 1] = pos;
+                        else
+                            std::sort(c.colIndices.begin() + first, c.colIndices.begin() + pos);
+                    }
+                }
+            }
+
+            return c;
+        }
+
+        /**
+         * Boolean C<M> = A x B, dot product form: entry (i, j) of the mask is kept if row i of A
+         * and column j of B intersect. B is passed as csc (csr of B^T), result rows are sorted as mask rows.
+         */
+        inline CsrMatrix multiplyMaskedDot(const CsrMatrix& a, const CsrMatrix& bt, const CsrMatrix& mask) {
+            assert(a.ncols == bt.ncols);
+            assert(mask.nrows == a.nrows);
+            assert(mask.ncols == bt.nrows);
+
+            std::vector<char> hit(mask.nvals(), 0);
+
+            CsrMatrix c;
+            c.nrows = a.nrows;
+            c.ncols = bt.nrows;
+            c.rowOffsets.assign(a.nrows + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (size_t i = 0; i < mask.nrows; i++) {
+                auto aFirst = a.colIndices.begin() + a.rowOffsets[i];
+                auto aLast = a.colIndices.begin() + a.rowOffsets[i + 1];
+                size_t count = 0;
+
+                for (size_t k = mask.rowOffsets[i]; k < mask.rowOffsets[i + 1] && aFirst != aLast; k++) {
+                    auto j = mask.colIndices[k];
+                    auto bFirst = bt.colIndices.begin() + bt.rowOffsets[j];
+                    auto bLast = bt.colIndices.begin() + bt.rowOffsets[j + 1];
+
+                    // Any common entry is enough for boolean result, so search stops on the first one
+                    while (aFirst != aLast && bFirst != bLast && *aFirst != *bFirst) {
+                        if (*aFirst < *bFirst)
+                            ++aFirst;
+                        else
+                            ++bFirst;
+                    }
+
+                    if (aFirst != aLast && bFirst != bLast) {
+                        hit[k] = 1;
+                        count += 1;
+                    }
+
+                    aFirst = a.colIndices.begin() + a.rowOffsets[i];
+                }
+
+                c.rowOffsets[i + 1] = count;
+            }
+
+            for (size_t i = 0; i < c.nrows; i++) {
+                c.rowOffsets[i + 1] += c.rowOffsets[i];
+            }
+
+            c.colIndices.resize(c.rowOffsets[c.nrows]);
+
+#pragma omp parallel for schedule(dynamic, 64)
+            for (size_t i = 0; i < mask.nrows; i++) {
+                size_t pos = c.rowOffsets[i];
+
+                for (size_t k = mask.rowOffsets[i]; k < mask.rowOffsets[i + 1]; k++) {
+                    if (hit[k])
+                        c.colIndices[pos++] = mask.colIndices[k];
+                }
+            }
+
+            return c;
+        }
+
+        /**
+         * Triangles count of undirected graph: sum of C<L> = L x L^T with plus-times semiring,
+         * where L is strictly lower triangular part of the adjacency matrix.
+         * Entry (i, j) of C is the size of intersection of rows i and j of L, so no transpose is required.
+         */
+        inline size_t triangleCount(const CsrMatrix& l) {
+            size_t triangles = 0;
+
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:triangles)
+            for (size_t i = 0; i < l.nrows; i++) {
+                auto iFirst = l.colIndices.begin() + l.rowOffsets[i];
+                auto iLast = l.colIndices.begin() + l.rowOffsets[i + 1];
+
+                for (auto it = iFirst; it != iLast; ++it) {
+                    auto j = *it;
+                    auto jFirst = l.colIndices.begin() + l.rowOffsets[j];
+                    auto jLast = l.colIndices.begin() + l.rowOffsets[j + 1];
+
+                    triangles += details::intersectionSize(iFirst, iLast, jFirst, jLast);
+                }
+            }
+
+            return triangles;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_SPGEMM_HPP
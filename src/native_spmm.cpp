@@ -0,0 +1,154 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+#include <native_csr.hpp>
+#include <native_convert.hpp>
+#include <native_spmm.hpp>
+
+#define BENCH_DEBUG
+
+namespace benchmark {
+    class MultiplyDense : public BenchmarkBase {
+    public:
+
+        MultiplyDense(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Dense operand X is n x columns with random entries set with given probability
+            columns = std::stoull(argsProcessor.getOption("columns", "64"));
+            density = std::stod(argsProcessor.getOption("density", "0.05"));
+            assert(columns > 0);
+
+            benchmarkName = "Native-SpMM-" + std::to_string(columns);
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiplyDense() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+
+        }
+
+        void tearDownBenchmark() override {
+
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+
+            // The same dense operand for all backends
+            dense = randomMatrix(input.ncols, columns, density, DENSE_SEED);
+
+#ifdef BENCH_DEBUG
+            log << ">   Dense operand: size " << dense.nrows << " x " << dense.ncols << " nvals: " << dense.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            A = native::cooToCsr(input);
+            X = native::bitsFromCoo(dense);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            dense = Matrix{};
+            A = native::CsrMatrix{};
+            X = native::BitMatrix{};
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Y = native::multiplyDense(A, X);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            size_t nvals = native::bitsCount(Y);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << columns << " nvals " << nvals << std::endl;
+#endif
+
+            addMetric("nvals", (double) nvals);
+            addMetric("density", (double) nvals / ((double) input.nrows * (double) columns));
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":spmm-" + std::to_string(columns) + "-" + ReferenceValues::numberKey(density),
+                             std::to_string(nvals));
+
+            Y = native::BitMatrix{};
+        }
+
+    protected:
+
+        static const size_t DENSE_SEED = 1;
+
+        native::CsrMatrix A;
+        native::BitMatrix X;
+        native::BitMatrix Y;
+
+        size_t columns;
+        double density;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+        Matrix dense;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiplyDense multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_NATIVE_SPMM_HPP
+#define SPBENCH_NATIVE_SPMM_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <matrix.hpp>
+#include <native_csr.hpp>
+
+namespace benchmark {
+    namespace native {
+
+        /** Dense boolean matrix, each row is packed into words of 64 columns */
+        struct BitMatrix {
+            size_t nrows = 0;
+            size_t ncols = 0;
+            size_t wordsPerRow = 0;
+            std::vector<uint64_t> words;
+
+            const uint64_t* row(size_t i) const {
+                return words.data() + i * wordsPerRow;
+            }
+
+            uint64_t* row(size_t i) {
+                return words.data() + i * wordsPerRow;
+            }
+        };
+
+        inline BitMatrix bitsFromCoo(const Matrix& m) {
+            BitMatrix x;
+            x.nrows = m.nrows;
+            x.ncols = m.ncols;
+            x.wordsPerRow = (m.ncols + 63) / 64;
+            x.words.assign(x.nrows * x.wordsPerRow, 0);
+
+            for (size_t k = 0; k < m.nvals; k++)
+                x.row(m.rows[k])[m.cols[k] / 64] |= 1ull << (m.cols[k] % 64);
+
+            return x;
+        }
+
+        /** @return Number of set bits */
+        inline size_t bitsCount(const BitMatrix& x) {
+            size_t count = 0;
+
+#pragma omp parallel for reduction(+:count)
+            for (size_t k = 0; k < x.words.size(); k++)
+                count += __builtin_popcountll(x.words[k]);
+
+            return count;
+        }
+
+        /**
+         * Sparse by dense boolean product Y = A x X, row of Y is OR of packed rows of X selected by row of A.
+         * Rows are independent, so there is no synchronization and no symbolic phase.
+         */
+        inline BitMatrix multiplyDense(const CsrMatrix& a, const BitMatrix& x) {
+            assert(a.ncols == x.nrows);
+
+            BitMatrix y;
+            y.nrows = a.nrows;
+            y.ncols = x.ncols;
+            y.wordsPerRow = x.wordsPerRow;
+            y.words.assign(y.nrows * y.wordsPerRow, 0);
+
+            size_t wordsPerRow = x.wordsPerRow;
+
+            if (wordsPerRow == 1) {
+#pragma omp parallel for schedule(dynamic, 256)
+                for (size_t i = 0; i < a.nrows; i++) {
+                    uint64_t acc = 0;
+                    for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++)
+                        acc |= x.words[a.colIndices[k]];
+                    y.words[i] = acc;
+                }
+
+                return y;
+            }
+
+#pragma omp parallel for schedule(dynamic, 256)
+            for (size_t i = 0; i < a.nrows; i++) {
+                uint64_t* yi = y.row(i);
+
+                for (size_t k = a.rowOffsets[i]; k < a.rowOffsets[i + 1]; k++) {
+                    const uint64_t* xj = x.row(a.colIndices[k]);
+                    for (size_t w = 0; w < wordsPerRow; w++)
+                        yi[w] |= xj[w];
+                }
+            }
+
+            return y;
+        }
+
+    }
+}
+
+#endif //SPBENCH_NATIVE_SPMM_HPP
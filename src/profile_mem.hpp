@@ -11,6 +11,10 @@
 #include <fstream>
 #include <string>
 
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 // Original: https://stackoverflow.com/questions/669438/how-to-get-memory-usage-at-runtime-using-c
 
 // On Linux, I've never found an ioctl() solution. For our applications,
@@ -65,6 +69,47 @@ void process_mem_usage(double& vm_usage, double& resident_set)
     resident_set = (double) rss * (double) page_size_kb;
 }
 
+//
+// reset_peak_mem_usage() - resets peak resident set size of the process (VmHWM)
+// to the current one, so the peak of the following region can be measured.
+// Free heap memory is returned to the system first, so it is not reused unnoticed.
+// Does nothing on kernels without /proc/self/clear_refs support.
+//
+
+void reset_peak_mem_usage()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+
+    std::ofstream clear_refs("/proc/self/clear_refs", std::ios_base::out);
+
+    if (clear_refs.is_open())
+        clear_refs << "5";
+}
+
+//
+// peak_mem_usage() - returns peak resident set size of the process (VmHWM) in KB.
+//
+// On failure, returns 0.0
+//
+
+double peak_mem_usage()
+{
+    std::ifstream status_stream("/proc/self/status", std::ios_base::in);
+    std::string key;
+
+    while (status_stream >> key) {
+        if (key == "VmHWM:") {
+            double peak = 0.0;
+            status_stream >> peak;
+            return peak;
+        }
+    }
+
+    return 0.0;
+}
+
 void output_mem_profile(const std::string& filename, const std::string& label) {
     std::ofstream s;
     s.open(filename, std::ios::app);
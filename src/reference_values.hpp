@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPBENCH_REFERENCE_VALUES_HPP
+#define SPBENCH_REFERENCE_VALUES_HPP
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <map>
+#include <cstdlib>
+#include <cstdio>
+
+namespace benchmark {
+
+    /**
+     * Cross-backend check of results: the first backend, which computes a value for the key (dataset and operation),
+     * stores it in the text file, other backends compare their values with the stored one.
+     *
+     * Golden file (data/golden.txt, or SPBENCH_GOLDEN environment variable) holds trusted values, it is never
+     * written and takes precedence over stored values. Each mismatch is reported to stderr and appended to Mismatches.txt.
+     */
+    class ReferenceValues {
+    public:
+
+        explicit ReferenceValues(std::string path, std::string goldenPath = getDefaultGoldenPath())
+                : path(std::move(path)), goldenPath(std::move(goldenPath)) {
+
+        }
+
+        /**
+         * Key prefix of the dataset: the same file or spec loaded as undirected graph is a different matrix,
+         * so such keys get `:u` suffix.
+         */
+        static std::string datasetKey(const std::string& name, bool isUndirected) {
+            return isUndirected ? name + ":u" : name;
+        }
+
+        /** Key part of a numeric option: parsed value with 6 significant digits, so `0.05` and `.050` give the same key */
+        static std::string numberKey(double value) {
+            char buffer[32];
+            std::snprintf(buffer, sizeof(buffer), "%g", value);
+            return buffer;
+        }
+
+        /**
+         * Compare value with the golden or reference one, or store it as reference if there is no value for the key yet.
+         * @return False if value differs from the golden or reference one
+         */
+        bool check(const std::string& key, const std::string& value) {
+            if (!goldenLoaded) {
+                load(goldenPath, golden);
+                goldenLoaded = true;
+            }
+
+            auto found = golden.find(key);
+
+            if (found != golden.end())
+                return compare(key, found->second, value, "golden");
+
+            load(path, values);
+
+            found = values.find(key);
+
+            if (found == values.end()) {
+                values[key] = value;
+
+                std::ofstream file(path, std::ios_base::out | std::ios_base::app);
+                file << key << " " << value << std::endl;
+
+                return true;
+            }
+
+            return compare(key, found->second, value, "reference");
+        }
+
+        static std::string getDefaultGoldenPath() {
+            const char* env = std::getenv("SPBENCH_GOLDEN");
+            return env != nullptr? std::string(env): std::string("data/golden.txt");
+        }
+
+    private:
+
+        static bool compare(const std::string& key, const std::string& expected, const std::string& value, const char* source) {
+            if (expected == value)
+                return true;
+
+            std::cerr << "Reference mismatch for " << key << ": expected " << expected << " got " << value
+                      << " (" << source << ")" << std::endl;
+
+            std::ofstream file("Mismatches.txt", std::ios_base::out | std::ios_base::app);
+            file << key << " expected " << expected << " got " << value << " " << source << std::endl;
+
+            return false;
+        }
+
+        /** Lines are "key value" pairs, lines which start from comment mark % are ignored */
+        static void load(const std::string& path, std::map<std::string, std::string>& values) {
+            values.clear();
+
+            std::ifstream file(path, std::ios_base::in);
+            std::string line;
+
+            while (std::getline(file, line)) {
+                if (!line.empty() && line[0] == '%')
+                    continue;
+
+                std::stringstream lineStream(line);
+                std::string key;
+                std::string value;
+
+                if (lineStream >> key >> value)
+                    values[key] = value;
+            }
+        }
+
+        std::string path;
+        std::string goldenPath;
+        std::map<std::string, std::string> values;
+        std::map<std::string, std::string> golden;
+        bool goldenLoaded = false;
+    };
+
+}
+
+#endif //SPBENCH_REFERENCE_VALUES_HPP
@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 #include <profile_mem.hpp>
 
 extern "C"
@@ -45,6 +48,12 @@ namespace benchmark {
             assert(argsProcessor.isParsed());
 
             benchmarkName = "SuiteSparse-Add";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -75,6 +84,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                 << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -129,9 +143,21 @@ namespace benchmark {
             GrB_CHECK(GrB_Matrix_ncols(&ncols, R));
             GrB_CHECK(GrB_Matrix_nvals(&nvals, R));
 
+            // Fingerprint is computed on extracted tuples, outside of measured region
+            std::vector<GrB_Index> I(nvals);
+            std::vector<GrB_Index> J(nvals);
+            GrB_CHECK(GrB_Matrix_extractTuples_BOOL(I.data(), J.data(), nullptr, &nvals, R));
+            auto fingerprint = fingerprintCoo(nvals, I.data(), J.data());
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":A+AA" + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+
+            addMetric("nvals", (double) nvals);
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << nrows << " x " << ncols
-                << " nvals " << nvals << std::endl;
+                << " nvals " << nvals << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             GrB_CHECK(GrB_Matrix_free(&R));
@@ -144,6 +170,8 @@ namespace benchmark {
         GrB_Matrix A2;
         GrB_Matrix R;
 
+        ReferenceValues references{"Reference-Values.txt"};
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
         Matrix input;
     };
@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class Bfs : public BenchmarkBase {
+    public:
+
+        Bfs(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // push: q<!v> = q x A with saxpy method
+            // pull: q<!v> = A^T x q with dot method over explicitly transposed matrix
+            // auto: direction-optimizing switching on frontier size
+            direction = argsProcessor.getOption("direction", "auto");
+            assert(direction == "push" || direction == "pull" || direction == "auto");
+
+            // Fixed source vertex, by default each iteration takes its own pseudo-random source
+            source = argsProcessor.getOption("source", "random");
+
+            benchmarkName = "SuiteSparse-Bfs-" + direction;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Bfs() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Level {
+            size_t frontier;
+            bool pull;
+            double ms;
+        };
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+
+            // Structural complement of visited set as mask, frontier is replaced on each level
+            for (auto desc: {&descPush, &descPull}) {
+                GrB_CHECK(GrB_Descriptor_new(desc));
+                GrB_CHECK(GrB_Descriptor_set(*desc, GrB_OUTP, GrB_REPLACE));
+                GrB_CHECK(GrB_Descriptor_set(*desc, GrB_MASK, GrB_COMP));
+                GrB_CHECK(GrB_Descriptor_set(*desc, GrB_MASK, GrB_STRUCTURE));
+            }
+
+            GrB_CHECK(GrB_Descriptor_set(descPush, GxB_AxB_METHOD, GxB_AxB_SAXPY));
+            GrB_CHECK(GrB_Descriptor_set(descPull, GxB_AxB_METHOD, GxB_AxB_DOT));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_Descriptor_free(&descPush));
+            GrB_CHECK(GrB_Descriptor_free(&descPull));
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+
+            // Rows of A^T are in edges, used by pull steps, transpose is not measured
+            if (direction != "push") {
+                if (type) {
+                    At = A;
+                }
+                else {
+                    GrB_CHECK(GrB_Matrix_new(&At, GrB_BOOL, n, n));
+                    GrB_CHECK(GrB_transpose(At, nullptr, nullptr, A, nullptr));
+                }
+            }
+
+            degrees.assign(n, 0);
+            for (size_t i = 0; i < input.nvals; i++)
+                degrees[input.rows[i]] += 1;
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+
+            if (At != nullptr && At != A)
+                GrB_CHECK(GrB_Matrix_free(&At));
+            At = nullptr;
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            A = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            start = source == "random" ? traversalSource(input, iterationIdx) : (unsigned int) std::stoul(source);
+            levels.clear();
+
+            GrB_CHECK(GrB_Vector_new(&v, GrB_INT32, input.nrows));
+            GrB_CHECK(GrB_Vector_new(&q, GrB_BOOL, input.nrows));
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+            GrB_Index n = input.nrows;
+            GrB_Index frontier = 1;
+            GrB_Index visited = 0;
+            bool pull = direction == "pull";
+
+            GrB_CHECK(GrB_Vector_setElement_BOOL(q, true, start));
+
+            for (int32_t depth = 0; frontier > 0; depth++) {
+                timer.start();
+
+                // v<q> = depth
+                GrB_CHECK(GrB_Vector_assign_INT32(v, q, nullptr, depth, GrB_ALL, n, GrB_DESC_S));
+                visited += frontier;
+
+                // Degrees are not known inside the library, so edges heuristic is approximated by vertices count
+                if (direction == "auto") {
+                    if (!pull && (double) frontier > (double) (n - visited) / ALPHA)
+                        pull = true;
+                    else if (pull && (double) frontier < (double) n / BETA)
+                        pull = false;
+                }
+
+                if (pull) {
+                    GrB_CHECK(GrB_mxv(q, v, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, At, q, descPull));
+                }
+                else {
+                    GrB_CHECK(GrB_vxm(q, v, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, q, A, descPush));
+                }
+
+                Level level{frontier, pull, 0.0};
+                GrB_CHECK(GrB_Vector_nvals(&frontier, q));
+
+                timer.end();
+                level.ms = timer.getElapsedTimeMs();
+                levels.push_back(level);
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            double pushMs = 0.0;
+            double pullMs = 0.0;
+
+            for (size_t i = 0; i < levels.size(); i++) {
+                auto& level = levels[i];
+                (level.pull ? pullMs : pushMs) += level.ms;
+
+#ifdef BENCH_DEBUG
+                log << "   level " << i << ": frontier " << level.frontier
+                    << (level.pull ? " pull " : " push ") << level.ms << " ms" << std::endl;
+#endif
+            }
+
+            GrB_Index reached;
+            GrB_CHECK(GrB_Vector_nvals(&reached, v));
+
+            std::vector<GrB_Index> I(reached);
+            std::vector<int32_t> X(reached);
+            GrB_CHECK(GrB_Vector_extractTuples_INT32(I.data(), X.data(), &reached, v));
+
+            // Traversed edges are all out edges of the reached vertices
+            size_t edges = 0;
+            int32_t depth = 0;
+
+            for (GrB_Index k = 0; k < reached; k++) {
+                edges += degrees[I[k]];
+                depth = std::max(depth, X[k]);
+            }
+
+            double totalMs = pushMs + pullMs;
+
+            addStageSample("push", pushMs);
+            addStageSample("pull", pullMs);
+
+            addMetric("levels", (double) levels.size());
+            addMetric("reached", (double) reached);
+            addMetric("MTEPS", totalMs > 0.0 ? (double) edges / totalMs / 1e3 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result: source " << start << " reached " << reached << " depth " << depth
+                << " traversed edges " << edges << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":bfs-" + std::to_string(start),
+                             std::to_string(reached) + ":" + std::to_string(depth));
+
+            GrB_CHECK(GrB_Vector_free(&v));
+            GrB_CHECK(GrB_Vector_free(&q));
+            v = nullptr;
+            q = nullptr;
+        }
+
+    protected:
+
+        static constexpr double ALPHA = 14.0;
+        static constexpr double BETA = 24.0;
+
+        GrB_Matrix A = nullptr;
+        GrB_Matrix At = nullptr;
+        GrB_Vector v = nullptr;
+        GrB_Vector q = nullptr;
+        GrB_Descriptor descPush = nullptr;
+        GrB_Descriptor descPull = nullptr;
+
+        std::vector<size_t> degrees;
+        std::vector<Level> levels;
+        unsigned int start = 0;
+
+        std::string direction;
+        std::string source;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Bfs bfs(argc, argv);
+    bfs.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,278 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <labeled_graph_loader.hpp>
+#include <grammar.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+#include <unordered_map>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class Cfpq : public BenchmarkBase {
+    public:
+
+        Cfpq(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            grammar = Grammar(getGrammarPath());
+
+            // Stop (not converged) if the index grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+
+            benchmarkName = "SuiteSparse-CFPQ-" + getGrammarName();
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Cfpq() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        std::string getGrammarPath() const {
+            return argsProcessor.getOption("grammar", "data/grammars/same_generation.txt");
+        }
+
+        std::string getGrammarName() const {
+            auto path = getGrammarPath();
+            auto name = path.substr(path.find_last_of('/') + 1);
+            return name.substr(0, name.find_last_of('.'));
+        }
+
+        void setupBenchmark() override {
+            grammar.loadData();
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            LabeledGraphLoader loader(file, type);
+            loader.loadData();
+
+            n = loader.getVerticesCount();
+
+            for (auto& label: loader.getLabels()) {
+                auto& input = label.matrix;
+
+#ifdef BENCH_DEBUG
+                log << ">   Load label: \"" << label.name << "\" of \"" << file << "\" isUndirected: " << type << std::endl
+                    << "                 size: " << n << " x " << n << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+                GrB_Matrix A = nullptr;
+                GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+                std::vector<GrB_Index> I(input.nvals);
+                std::vector<GrB_Index> J(input.nvals);
+
+                bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+                for (auto i = 0; i < input.nvals; i++) {
+                    I[i] = input.rows[i];
+                    J[i] = input.cols[i];
+                    X[i] = true;
+                }
+
+                GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+                std::free(X);
+
+                labels[label.name] = A;
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            for (auto& label: labels) {
+                GrB_CHECK(GrB_Matrix_free(&label.second));
+            }
+
+            labels.clear();
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            iterations = 0;
+            mxmCalls = 0;
+            addCalls = 0;
+            converged = false;
+
+            T.assign(grammar.getNonterminalsCount(), nullptr);
+            nvals.assign(grammar.getNonterminalsCount(), 0);
+
+            for (auto& t: T) {
+                GrB_CHECK(GrB_Matrix_new(&t, GrB_BOOL, n, n));
+            }
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Timer timer;
+            double mxmMs = 0.0;
+            double addMs = 0.0;
+
+            if (!grammar.getEpsRules().empty()) {
+                GrB_Matrix E = nullptr;
+                GrB_CHECK(GrB_Matrix_new(&E, GrB_BOOL, n, n));
+
+                for (GrB_Index i = 0; i < n; i++) {
+                    GrB_CHECK(GrB_Matrix_setElement_BOOL(E, true, i, i));
+                }
+
+                for (auto left: grammar.getEpsRules()) {
+                    GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(T[left], nullptr, nullptr, GrB_LOR, T[left], E, nullptr));
+                }
+
+                GrB_CHECK(GrB_Matrix_free(&E));
+            }
+
+            for (auto& rule: grammar.getTerminalRules()) {
+                auto found = labels.find(rule.terminal);
+                if (found != labels.end()) {
+                    GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(T[rule.left], nullptr, nullptr, GrB_LOR, T[rule.left], found->second, nullptr));
+                }
+            }
+
+            for (size_t i = 0; i < T.size(); i++) {
+                GrB_CHECK(GrB_Matrix_nvals(&nvals[i], T[i]));
+            }
+
+            bool changed = true;
+
+            while (changed && !exceedsBudget()) {
+                changed = false;
+                iterations += 1;
+
+                for (auto& rule: grammar.getBinaryRules()) {
+                    GrB_Matrix P = nullptr;
+
+                    // mxm and add are not fused by accumulator, so calls are counted in the same way as for other backends
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_new(&P, GrB_BOOL, n, n));
+                    GrB_CHECK(GrB_mxm(P, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, T[rule.first], T[rule.second], nullptr));
+                    timer.end();
+                    mxmMs += timer.getElapsedTimeMs();
+                    mxmCalls += 1;
+
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(T[rule.left], nullptr, nullptr, GrB_LOR, T[rule.left], P, nullptr));
+                    timer.end();
+                    addMs += timer.getElapsedTimeMs();
+                    addCalls += 1;
+
+                    GrB_CHECK(GrB_Matrix_free(&P));
+
+                    GrB_Index updated;
+                    GrB_CHECK(GrB_Matrix_nvals(&updated, T[rule.left]));
+
+                    changed = changed || updated != nvals[rule.left];
+                    nvals[rule.left] = updated;
+                }
+            }
+
+            converged = !changed;
+
+            addStageSample("mxm", mxmMs);
+            addStageSample("add", addMs);
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            addMetric("iterations", (double) iterations);
+            addMetric("mxm calls", (double) mxmCalls);
+            addMetric("add calls", (double) addCalls);
+            addMetric("nvals", (double) nvals[grammar.getStart()]);
+            addMetric("converged", converged ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            for (size_t i = 0; i < T.size(); i++) {
+                log << "   Nonterminal " << grammar.getNonterminal(i) << ": size " << n << " x " << n
+                    << " nvals " << nvals[i] << std::endl;
+            }
+
+            log << "   Result: iterations " << iterations << " mxm calls " << mxmCalls << " add calls " << addCalls
+                << " converged " << converged << std::endl;
+#endif
+
+            for (auto& t: T) {
+                GrB_CHECK(GrB_Matrix_free(&t));
+            }
+
+            T.clear();
+        }
+
+        bool exceedsBudget() const {
+            if (maxNvals == 0)
+                return false;
+
+            size_t total = 0;
+            for (auto v: nvals) {
+                total += v;
+            }
+
+            return total > maxNvals;
+        }
+
+    protected:
+
+        ArgsProcessor argsProcessor;
+        Grammar grammar;
+
+        size_t n = 0;
+        std::unordered_map<std::string, GrB_Matrix> labels;
+        std::vector<GrB_Matrix> T;
+        std::vector<GrB_Index> nvals;
+
+        size_t maxNvals;
+        size_t iterations = 0;
+        size_t mxmCalls = 0;
+        size_t addCalls = 0;
+        bool converged = false;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Cfpq cfpq(argc, argv);
+    cfpq.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class Closure : public BenchmarkBase {
+    public:
+
+        Closure(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // squaring: R = R + R x R until fixpoint
+            // seminaive: D<!R> = D x A, R = R + D until D is empty
+            mode = argsProcessor.getOption("mode", "squaring");
+            assert(mode == "squaring" || mode == "seminaive");
+
+            // Stop (not converged) if closure grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+            maxSteps = std::stoull(argsProcessor.getOption("max-steps", "0"));
+
+            benchmarkName = "SuiteSparse-Closure-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Closure() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Step {
+            GrB_Index nvals;
+            GrB_Index deltaNvals;
+            double mxmMs;
+            double addMs;
+        };
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            A = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            steps.clear();
+            converged = false;
+            nvals = input.nvals;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            size_t n = input.nrows;
+            Timer timer;
+
+            GrB_CHECK(GrB_Matrix_dup(&R, A));
+
+            if (mode == "squaring") {
+                while (!stop()) {
+                    Step step{};
+                    GrB_Matrix P = nullptr;
+
+                    // mxm and add are not fused by accumulator, so per step breakdown is the same as for other backends
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_new(&P, GrB_BOOL, n, n));
+                    GrB_CHECK(GrB_mxm(P, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, R, R, nullptr));
+                    timer.end();
+                    step.mxmMs = timer.getElapsedTimeMs();
+
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(R, nullptr, nullptr, GrB_LOR, R, P, nullptr));
+                    timer.end();
+                    step.addMs = timer.getElapsedTimeMs();
+
+                    GrB_CHECK(GrB_Matrix_free(&P));
+
+                    GrB_CHECK(GrB_Matrix_nvals(&step.nvals, R));
+                    step.deltaNvals = step.nvals - nvals;
+                    nvals = step.nvals;
+                    converged = step.deltaNvals == 0;
+
+                    steps.push_back(step);
+                }
+            }
+            else {
+                GrB_Matrix D = nullptr;
+                GrB_CHECK(GrB_Matrix_dup(&D, A));
+
+                while (!stop()) {
+                    Step step{};
+
+                    // Complemented structural mask of R drops already known pairs inside of mxm
+                    timer.start();
+                    GrB_CHECK(GrB_mxm(D, R, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, D, A, GrB_DESC_RSC));
+                    timer.end();
+                    step.mxmMs = timer.getElapsedTimeMs();
+
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(R, nullptr, nullptr, GrB_LOR, R, D, nullptr));
+                    timer.end();
+                    step.addMs = timer.getElapsedTimeMs();
+
+                    GrB_CHECK(GrB_Matrix_nvals(&step.deltaNvals, D));
+                    GrB_CHECK(GrB_Matrix_nvals(&step.nvals, R));
+                    nvals = step.nvals;
+                    converged = step.deltaNvals == 0;
+
+                    steps.push_back(step);
+                }
+
+                GrB_CHECK(GrB_Matrix_free(&D));
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Step total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.mxmMs += step.mxmMs;
+                total.addMs += step.addMs;
+
+#ifdef BENCH_DEBUG
+                log << "   step " << i << ": nvals " << step.nvals << " (+" << step.deltaNvals << ")"
+                    << " mxm " << step.mxmMs << " ms add " << step.addMs << " ms" << std::endl;
+#endif
+            }
+
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("add", total.addMs);
+
+            addMetric("steps", (double) steps.size());
+            addMetric("nvals", (double) nvals);
+            addMetric("converged", converged ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols
+                << " nvals " << nvals << " steps " << steps.size() << " converged " << converged << std::endl;
+#endif
+
+            GrB_CHECK(GrB_Matrix_free(&R));
+            R = nullptr;
+        }
+
+        bool stop() const {
+            return converged ||
+                   (maxNvals > 0 && nvals > maxNvals) ||
+                   (maxSteps > 0 && steps.size() >= maxSteps);
+        }
+
+    protected:
+
+        GrB_Matrix A = nullptr;
+        GrB_Matrix R = nullptr;
+
+        std::string mode;
+        size_t maxNvals;
+        size_t maxSteps;
+
+        std::vector<Step> steps;
+        GrB_Index nvals = 0;
+        bool converged = false;
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Closure closure(argc, argv);
+    closure.runBenchmark();
+    return 0;
+}
@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class Components : public BenchmarkBase {
+    public:
+
+        Components(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            benchmarkName = "SuiteSparse-Components-FastSV";
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Components() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Step {
+            double hookMs;
+            double shortcutMs;
+        };
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            // Components of directed graph are weakly connected ones, so graph is always loaded as undirected
+            MatrixLoader loader(file, true);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << " (loaded as undirected)" << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+
+            vertices.resize(n);
+            parents.resize(n);
+
+            for (size_t i = 0; i < n; i++)
+                vertices[i] = i;
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            vertices.clear();
+            parents.clear();
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            A = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_Index n = input.nrows;
+
+            // Each vertex is its own parent, all vectors are full
+            GrB_CHECK(GrB_Vector_new(&f, GrB_UINT64, n));
+            GrB_CHECK(GrB_Vector_build_UINT64(f, vertices.data(), vertices.data(), n, GrB_PLUS_UINT64));
+            GrB_CHECK(GrB_Vector_dup(&gp, f));
+            GrB_CHECK(GrB_Vector_dup(&mngp, f));
+            GrB_CHECK(GrB_Vector_new(&gpNew, GrB_UINT64, n));
+            GrB_CHECK(GrB_Vector_new(&diff, GrB_BOOL, n));
+
+            steps.clear();
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_Index n = input.nrows;
+            Timer timer;
+            bool changed = true;
+
+            while (changed) {
+                Step step{};
+
+                timer.start();
+
+                // Hooking: mngp = min(mngp, A min.second gp), minimal grandparent among neighbors
+                GrB_CHECK(GrB_mxv(mngp, nullptr, GrB_MIN_UINT64, GrB_MIN_SECOND_SEMIRING_UINT64, A, gp, nullptr));
+
+                // Stochastic hooking: f[f[i]] = min(f[f[i]], mngp[i]), duplicated indices are reduced by accumulator
+                GrB_CHECK(GrB_Vector_extractTuples_UINT64(vertices.data(), parents.data(), &n, f));
+                GrB_CHECK(GrB_Vector_assign(f, nullptr, GrB_MIN_UINT64, mngp, parents.data(), n, nullptr));
+
+                // Aggressive hooking: f = min(f, mngp)
+                GrB_CHECK(GrB_Vector_eWiseMult_BinaryOp(f, nullptr, nullptr, GrB_MIN_UINT64, f, mngp, nullptr));
+
+                timer.end();
+                step.hookMs = timer.getElapsedTimeMs();
+
+                timer.start();
+
+                // Shortcutting: f = min(f, gp), gp = f[f]
+                GrB_CHECK(GrB_Vector_eWiseMult_BinaryOp(f, nullptr, nullptr, GrB_MIN_UINT64, f, gp, nullptr));
+                GrB_CHECK(GrB_Vector_extractTuples_UINT64(vertices.data(), parents.data(), &n, f));
+                GrB_CHECK(GrB_Vector_extract(gpNew, nullptr, nullptr, f, parents.data(), n, nullptr));
+
+                // Converged, if grandparents are not changed
+                GrB_CHECK(GrB_Vector_eWiseMult_BinaryOp(diff, nullptr, nullptr, GrB_NE_UINT64, gpNew, gp, nullptr));
+                GrB_CHECK(GrB_Vector_reduce_BOOL(&changed, nullptr, GrB_LOR_MONOID_BOOL, diff, nullptr));
+                std::swap(gp, gpNew);
+
+                timer.end();
+                step.shortcutMs = timer.getElapsedTimeMs();
+
+                steps.push_back(step);
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Step total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.hookMs += step.hookMs;
+                total.shortcutMs += step.shortcutMs;
+
+#ifdef BENCH_DEBUG
+                log << "   iteration " << i << ": hook " << step.hookMs << " ms shortcut " << step.shortcutMs << " ms" << std::endl;
+#endif
+            }
+
+            addStageSample("hook", total.hookMs);
+            addStageSample("shortcut", total.shortcutMs);
+
+            // Labels are indices of vertices, which are roots of components
+            GrB_Index n = input.nrows;
+            GrB_CHECK(GrB_Vector_extractTuples_UINT64(vertices.data(), parents.data(), &n, f));
+
+            auto signature = componentsSignature(parents);
+            auto components = std::stoull(signature.substr(0, signature.find(':')));
+
+            addMetric("iterations", (double) steps.size());
+            addMetric("components", (double) components);
+
+#ifdef BENCH_DEBUG
+            log << "   Result: components " << components << " signature " << signature << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, true) + ":components", signature);
+
+            for (auto v: {&f, &gp, &mngp, &gpNew, &diff}) {
+                GrB_CHECK(GrB_Vector_free(v));
+                *v = nullptr;
+            }
+        }
+
+    protected:
+
+        GrB_Matrix A = nullptr;
+        GrB_Vector f = nullptr;
+        GrB_Vector gp = nullptr;
+        GrB_Vector mngp = nullptr;
+        GrB_Vector gpNew = nullptr;
+        GrB_Vector diff = nullptr;
+
+        std::vector<GrB_Index> vertices;
+        std::vector<GrB_Index> parents;
+        std::vector<Step> steps;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Components components(argc, argv);
+    components.runBenchmark();
+    return 0;
+}
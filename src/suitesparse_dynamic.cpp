@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+#include <memory>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class Dynamic : public BenchmarkBase {
+    public:
+
+        Dynamic(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // incremental: C += A x dA + dA x (A + dA), full: C = (A + dA) x (A + dA) for each batch
+            mode = argsProcessor.getOption("mode", "incremental");
+            assert(mode == "incremental" || mode == "full");
+
+            // Stream of insertion batches is split off the dataset
+            batchesCount = std::stoull(argsProcessor.getOption("batches", "10"));
+            batchSize = std::stoull(argsProcessor.getOption("batch-size", "1000"));
+            seed = std::stoull(argsProcessor.getOption("seed", "1"));
+            assert(batchSize > 0);
+
+            benchmarkName = "SuiteSparse-Dynamic-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~Dynamic() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Batch {
+            GrB_Index nvals;
+            double updateMs;
+            double mxmMs;
+            double mergeMs;
+        };
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+
+            assert(input.nrows == input.ncols);
+
+            splitStream(input, batchesCount, batchSize, seed, base, batches);
+
+#ifdef BENCH_DEBUG
+            log << ">   Stream: base nvals " << base.nvals << " batches " << batches.size()
+                << " batch size " << batchSize << " seed " << seed << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = base.nrows;
+            GrB_CHECK(GrB_Matrix_new(&A0, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(base.nvals);
+            std::vector<GrB_Index> J(base.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * base.nvals);
+
+            for (auto i = 0; i < base.nvals; i++) {
+                I[i] = base.rows[i];
+                J[i] = base.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A0, I.data(), J.data(), X, base.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+
+            GrB_CHECK(GrB_Matrix_new(&C0, GrB_BOOL, n, n));
+            GrB_CHECK(GrB_mxm(C0, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, A0, A0, nullptr));
+
+            // Tuples of batches are prepared here, matrices are built inside of the measured region
+            batchRows.resize(batches.size());
+            batchCols.resize(batches.size());
+
+            for (size_t b = 0; b < batches.size(); b++) {
+                batchRows[b].assign(batches[b].rows.begin(), batches[b].rows.end());
+                batchCols[b].assign(batches[b].cols.begin(), batches[b].cols.end());
+            }
+
+            batchValues.reset(new bool[batchSize]);
+            std::fill(batchValues.get(), batchValues.get() + batchSize, true);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            base = Matrix{};
+            batches.clear();
+            batchRows.clear();
+            batchCols.clear();
+
+            GrB_CHECK(GrB_Matrix_free(&A0));
+            GrB_CHECK(GrB_Matrix_free(&C0));
+            A0 = nullptr;
+            C0 = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Each iteration starts from the same base graph and its square
+            GrB_CHECK(GrB_Matrix_dup(&A, A0));
+            GrB_CHECK(GrB_Matrix_dup(&C, C0));
+            steps.clear();
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_Index n = input.nrows;
+            Timer timer;
+
+            for (size_t b = 0; b < batches.size(); b++) {
+                Batch step{};
+                GrB_Matrix dA = nullptr;
+
+                timer.start();
+                GrB_CHECK(GrB_Matrix_new(&dA, GrB_BOOL, n, n));
+                GrB_CHECK(GrB_Matrix_build_BOOL(dA, batchRows[b].data(), batchCols[b].data(),
+                                                batchValues.get(), batches[b].nvals, GrB_FIRST_BOOL));
+                timer.end();
+                step.updateMs += timer.getElapsedTimeMs();
+
+                if (mode == "incremental") {
+                    // C += A x dA, products are accumulated into C inside of mxm
+                    timer.start();
+                    GrB_CHECK(GrB_mxm(C, nullptr, GrB_LOR, GrB_LOR_LAND_SEMIRING_BOOL, A, dA, nullptr));
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_assign(A, nullptr, GrB_LOR, dA, GrB_ALL, n, GrB_ALL, n, nullptr));
+                    timer.end();
+                    step.updateMs += timer.getElapsedTimeMs();
+
+                    // C += dA x (A + dA) = dA x A + dA x dA
+                    timer.start();
+                    GrB_CHECK(GrB_mxm(C, nullptr, GrB_LOR, GrB_LOR_LAND_SEMIRING_BOOL, dA, A, nullptr));
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+                }
+                else {
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_assign(A, nullptr, GrB_LOR, dA, GrB_ALL, n, GrB_ALL, n, nullptr));
+                    timer.end();
+                    step.updateMs += timer.getElapsedTimeMs();
+
+                    timer.start();
+                    GrB_CHECK(GrB_Matrix_free(&C));
+                    GrB_CHECK(GrB_Matrix_new(&C, GrB_BOOL, n, n));
+                    GrB_CHECK(GrB_mxm(C, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, A, A, nullptr));
+                    timer.end();
+                    step.mxmMs += timer.getElapsedTimeMs();
+                }
+
+                GrB_CHECK(GrB_Matrix_free(&dA));
+                GrB_CHECK(GrB_Matrix_nvals(&step.nvals, C));
+                steps.push_back(step);
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_Index nvals;
+            GrB_CHECK(GrB_Matrix_nvals(&nvals, C));
+
+            Batch total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.updateMs += step.updateMs;
+                total.mxmMs += step.mxmMs;
+                total.mergeMs += step.mergeMs;
+
+#ifdef BENCH_DEBUG
+                log << "   batch " << i << ": nvals " << step.nvals << " update " << step.updateMs << " ms mxm " << step.mxmMs << " ms merge " << step.mergeMs << " ms"
+                    << std::endl;
+#endif
+            }
+
+            double batchMs = total.updateMs + total.mxmMs + total.mergeMs;
+
+            addStageSample("update", total.updateMs);
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("merge", total.mergeMs);
+
+            addMetric("batches", (double) steps.size());
+            addMetric("batch ms", steps.empty() ? 0.0 : batchMs / (double) steps.size());
+            addMetric("nvals", (double) nvals);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols << " nvals " << nvals << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":dynamic-square-" + std::to_string(batchesCount) + "-" +
+                             std::to_string(batchSize) + "-" + std::to_string(seed), std::to_string(nvals));
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            GrB_CHECK(GrB_Matrix_free(&C));
+            A = nullptr;
+            C = nullptr;
+        }
+
+    protected:
+
+        GrB_Matrix A0 = nullptr;
+        GrB_Matrix C0 = nullptr;
+        GrB_Matrix A = nullptr;
+        GrB_Matrix C = nullptr;
+
+        std::string mode;
+        size_t batchesCount;
+        size_t batchSize;
+        size_t seed;
+
+        Matrix base;
+        std::vector<Matrix> batches;
+        std::vector<std::vector<GrB_Index>> batchRows;
+        std::vector<std::vector<GrB_Index>> batchCols;
+        std::unique_ptr<bool[]> batchValues;
+        std::vector<Batch> steps;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::Dynamic dynamic(argc, argv);
+    dynamic.runBenchmark();
+    return 0;
+}
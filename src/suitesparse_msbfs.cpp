@@ -0,0 +1,231 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class MultiSourceBfs : public BenchmarkBase {
+    public:
+
+        MultiSourceBfs(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Number of bfs traversals per iteration, each one is run separately with vxm
+            sourcesCount = std::stoull(argsProcessor.getOption("sources", "256"));
+            assert(sourcesCount > 0);
+
+            benchmarkName = "SuiteSparse-MsBfs";
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiSourceBfs() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+
+            // Out degrees, so traversed edges of each bfs are reduced inside the library
+            std::vector<uint64_t> degrees(n, 0);
+            for (size_t i = 0; i < input.nvals; i++)
+                degrees[input.rows[i]] += 1;
+
+            std::vector<GrB_Index> vertices(n);
+            for (size_t i = 0; i < n; i++)
+                vertices[i] = i;
+
+            GrB_CHECK(GrB_Vector_new(&D, GrB_UINT64, n));
+            GrB_CHECK(GrB_Vector_build_UINT64(D, vertices.data(), degrees.data(), n, GrB_PLUS_UINT64));
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+
+            GrB_CHECK(GrB_Vector_free(&D));
+            GrB_CHECK(GrB_Matrix_free(&A));
+            D = nullptr;
+            A = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            sources.resize(sourcesCount);
+
+            for (size_t k = 0; k < sourcesCount; k++)
+                sources[k] = traversalSource(input, iterationIdx * sourcesCount + k);
+
+            reachedPairs = 0;
+            traversedEdges = 0;
+            maxLevels = 0;
+
+            GrB_CHECK(GrB_Vector_new(&v, GrB_BOOL, input.nrows));
+            GrB_CHECK(GrB_Vector_new(&q, GrB_BOOL, input.nrows));
+            GrB_CHECK(GrB_Vector_new(&t, GrB_UINT64, input.nrows));
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_Index n = input.nrows;
+            Timer timer;
+            timer.start();
+
+            for (auto source: sources) {
+                GrB_Index frontier = 1;
+                size_t levels = 0;
+
+                GrB_CHECK(GrB_Vector_clear(v));
+                GrB_CHECK(GrB_Vector_clear(q));
+                GrB_CHECK(GrB_Vector_setElement_BOOL(q, true, source));
+
+                while (frontier > 0) {
+                    // v<q> = true, q<!v> = q x A
+                    GrB_CHECK(GrB_Vector_assign_BOOL(v, q, nullptr, true, GrB_ALL, n, GrB_DESC_S));
+                    GrB_CHECK(GrB_vxm(q, v, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, q, A, GrB_DESC_RSC));
+                    GrB_CHECK(GrB_Vector_nvals(&frontier, q));
+                    levels += 1;
+                }
+
+                GrB_Index reached;
+                uint64_t edges = 0;
+
+                GrB_CHECK(GrB_Vector_nvals(&reached, v));
+                GrB_CHECK(GrB_Vector_eWiseMult_BinaryOp(t, nullptr, nullptr, GrB_SECOND_UINT64, v, D, GrB_DESC_R));
+                GrB_CHECK(GrB_Vector_reduce_UINT64(&edges, nullptr, GrB_PLUS_MONOID_UINT64, t, nullptr));
+
+                reachedPairs += reached;
+                traversedEdges += edges;
+                maxLevels = std::max(maxLevels, levels);
+            }
+
+            timer.end();
+            traversalMs = timer.getElapsedTimeMs();
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+#ifdef BENCH_DEBUG
+            log << "   Result: sources " << sourcesCount << " reached pairs " << reachedPairs
+                << " traversed edges " << traversedEdges << " max levels " << maxLevels << std::endl;
+#endif
+
+            addMetric("reached pairs", (double) reachedPairs);
+            addMetric("traversed edges", (double) traversedEdges);
+            addMetric("MTEPS", traversalMs > 0.0 ? (double) traversedEdges / traversalMs / 1e3 : 0.0);
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":msbfs-" + std::to_string(sourcesCount) + "-" + std::to_string(iterationIdx),
+                             std::to_string(reachedPairs) + ":" + std::to_string(traversedEdges));
+
+            GrB_CHECK(GrB_Vector_free(&v));
+            GrB_CHECK(GrB_Vector_free(&q));
+            GrB_CHECK(GrB_Vector_free(&t));
+            v = nullptr;
+            q = nullptr;
+            t = nullptr;
+        }
+
+    protected:
+
+        GrB_Matrix A = nullptr;
+        GrB_Vector D = nullptr;
+        GrB_Vector v = nullptr;
+        GrB_Vector q = nullptr;
+        GrB_Vector t = nullptr;
+
+        std::vector<unsigned int> sources;
+        size_t reachedPairs = 0;
+        size_t traversedEdges = 0;
+        size_t maxLevels = 0;
+        double traversalMs = 0.0;
+
+        size_t sourcesCount;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiSourceBfs bfs(argc, argv);
+    bfs.runBenchmark();
+    return 0;
+}
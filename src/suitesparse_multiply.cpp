@@ -25,6 +25,9 @@
 #include <benchmark_base.hpp>
 #include <matrix_loader.hpp>
 #include <args_processor.hpp>
+#include <matrix_reorder.hpp>
+#include <matrix_utils.hpp>
+#include <reference_values.hpp>
 #include <profile_mem.hpp>
 
 extern "C"
@@ -43,7 +46,32 @@ namespace benchmark {
             argsProcessor.parse(argc, argv);
             assert(argsProcessor.isParsed());
 
-            benchmarkName = "SuiteSparse-Multiply";
+            // AA, AAt (A x A^T) or AtA (A^T x A)
+            op = argsProcessor.getOption("op", "AA");
+            assert(op == "AA" || op == "AAt" || op == "AtA");
+
+            // descriptor: transpose is done by mxm itself (GrB_DESC_T1 / GrB_DESC_T0)
+            // cached: A^T is built in experiment setup, outside of measured region
+            // inline: A^T is built on each iteration, inside of measured region
+            transposeMode = argsProcessor.getOption("transpose", "descriptor");
+            assert(transposeMode == "descriptor" || transposeMode == "cached" || transposeMode == "inline");
+
+            // full: result with values is computed by LOR_LAND semiring
+            // symbolic: structure only ANY_PAIR product and its row sizes, there is no symbolic-only mxm in GraphBLAS
+            // hash: structure only ANY_PAIR product, which is fingerprinted from extracted tuples
+            output = argsProcessor.getOption("output", "full");
+            assert(output == "full" || output == "symbolic" || output == "hash");
+            semiring = output == "full"? GrB_LOR_LAND_SEMIRING_BOOL: GxB_ANY_PAIR_BOOL;
+
+            benchmarkName = op == "AA" ? "SuiteSparse-Multiply" : "SuiteSparse-Multiply-" + op + "-" + transposeMode;
+            if (output != "full")
+                benchmarkName += output == "symbolic"? "-Symbolic": "-Hash";
+
+            // Relabel input with --reorder=rcm|degree|hub|community, cost is reported as metric
+            reorder = MatrixReorder(argsProcessor.getOption("reorder", "none"));
+            if (reorder.isEnabled())
+                benchmarkName += "-Reorder-" + reorder.getOrdering();
+
             experimentsCount = argsProcessor.getExperimentsCount();
         }
 
@@ -74,6 +102,11 @@ namespace benchmark {
             loader.loadData();
             input = std::move(loader.getMatrix());
 
+            if (reorder.isEnabled()) {
+                reorder.reorder(input);
+                addMetric("reorder ms", reorder.getElapsedTimeMs());
+            }
+
 #ifdef BENCH_DEBUG
             log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
                 << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
@@ -98,6 +131,18 @@ namespace benchmark {
             GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
 
             std::free(X);
+
+            if (op != "AA" && transposeMode == "cached") {
+                Timer timer;
+                timer.start();
+                GrB_CHECK(GrB_Matrix_new(&At, GrB_BOOL, n, n));
+                GrB_CHECK(GrB_transpose(At, nullptr, nullptr, A, nullptr));
+                timer.end();
+
+#ifdef BENCH_DEBUG
+                log << ">   Transpose (outside of measured region): " << timer.getElapsedTimeMs() << " ms" << std::endl;
+#endif // BENCH_DEBUG
+            }
         }
 
         void tearDownExperiment(size_t experimentIdx) override {
@@ -105,14 +150,75 @@ namespace benchmark {
 
             GrB_CHECK(GrB_Matrix_free(&A));
             A = nullptr;
+
+            if (At != nullptr) {
+                GrB_CHECK(GrB_Matrix_free(&At));
+                At = nullptr;
+            }
         }
 
         void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
             GrB_CHECK(GrB_Matrix_new(&R, GrB_BOOL, input.nrows, input.ncols));
+
+            if (output == "symbolic") {
+                GrB_CHECK(GrB_Vector_new(&rowSizes, GrB_UINT64, input.nrows));
+            }
         }
 
         void execIteration(size_t experimentIdx, size_t iterationIdx) override {
-            GrB_CHECK(GrB_mxm(R, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, A, A, nullptr));
+            product();
+
+            Timer timer;
+
+            if (output == "symbolic") {
+                timer.start();
+                GrB_CHECK(GrB_Matrix_reduce_Monoid(rowSizes, nullptr, nullptr, GrB_PLUS_MONOID_UINT64, R, nullptr));
+                timer.end();
+
+                addStageSample("row sizes", timer.getElapsedTimeMs());
+            }
+            else if (output == "hash") {
+                timer.start();
+                fingerprint = hash(R);
+                timer.end();
+
+                addStageSample("hash", timer.getElapsedTimeMs());
+            }
+        }
+
+        void product() {
+            if (op == "AA") {
+                GrB_CHECK(GrB_mxm(R, nullptr, nullptr, semiring, A, A, nullptr));
+                return;
+            }
+
+            if (transposeMode == "descriptor") {
+                GrB_Descriptor desc = op == "AAt" ? GrB_DESC_T1 : GrB_DESC_T0;
+                GrB_CHECK(GrB_mxm(R, nullptr, nullptr, semiring, A, A, desc));
+                return;
+            }
+
+            Timer timer;
+
+            if (transposeMode == "inline") {
+                timer.start();
+                GrB_CHECK(GrB_Matrix_new(&At, GrB_BOOL, input.ncols, input.nrows));
+                GrB_CHECK(GrB_transpose(At, nullptr, nullptr, A, nullptr));
+                timer.end();
+
+                addStageSample("transpose", timer.getElapsedTimeMs());
+            }
+
+            timer.start();
+            if (op == "AAt") {
+                GrB_CHECK(GrB_mxm(R, nullptr, nullptr, semiring, A, At, nullptr));
+            }
+            else {
+                GrB_CHECK(GrB_mxm(R, nullptr, nullptr, semiring, At, A, nullptr));
+            }
+            timer.end();
+
+            addStageSample("multiply", timer.getElapsedTimeMs());
         }
 
         void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
@@ -124,20 +230,62 @@ namespace benchmark {
             GrB_CHECK(GrB_Matrix_ncols(&ncols, R));
             GrB_CHECK(GrB_Matrix_nvals(&nvals, R));
 
+            addMetric("nvals", (double) nvals);
+
+            // In hash mode fingerprint is a part of measured region, otherwise it is computed here
+            if (output != "hash")
+                fingerprint = hash(R);
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            bool valid = references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":" + op + reorder.getKeySuffix() + ":fingerprint", fingerprint.toString());
+            addMetric("verified", valid ? 1.0 : 0.0);
+
 #ifdef BENCH_DEBUG
             log << "   Result matrix: size " << nrows << " x " << ncols
-                << " nvals " << nvals << std::endl;
+                << " nvals " << nvals << " fingerprint " << fingerprint.toString() << std::endl;
 #endif
 
             GrB_CHECK(GrB_Matrix_free(&R));
             R = nullptr;
+
+            if (rowSizes != nullptr) {
+                GrB_CHECK(GrB_Vector_free(&rowSizes));
+                rowSizes = nullptr;
+            }
+
+            if (transposeMode == "inline" && At != nullptr) {
+                GrB_CHECK(GrB_Matrix_free(&At));
+                At = nullptr;
+            }
+        }
+
+        static Fingerprint hash(GrB_Matrix M) {
+            GrB_Index nvals;
+            GrB_CHECK(GrB_Matrix_nvals(&nvals, M));
+
+            std::vector<GrB_Index> I(nvals);
+            std::vector<GrB_Index> J(nvals);
+            GrB_CHECK(GrB_Matrix_extractTuples_BOOL(I.data(), J.data(), nullptr, &nvals, M));
+
+            return fingerprintCoo(nvals, I.data(), J.data());
         }
 
     protected:
 
-        GrB_Matrix A;
-        GrB_Matrix R;
+        GrB_Matrix A = nullptr;
+        GrB_Matrix At = nullptr;
+        GrB_Matrix R = nullptr;
+        GrB_Vector rowSizes = nullptr;
+        GrB_Semiring semiring = nullptr;
+
+        Fingerprint fingerprint;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        std::string op;
+        std::string transposeMode;
+        std::string output;
 
+        MatrixReorder reorder;
         ArgsProcessor argsProcessor;
         Matrix input;
     };
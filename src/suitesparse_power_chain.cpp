@@ -0,0 +1,320 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class PowerChain : public BenchmarkBase {
+    public:
+
+        PowerChain(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // power: A^k, sum: A + A^2 + ... + A^k (k-hop neighborhood)
+            result = argsProcessor.getOption("result", "sum");
+            assert(result == "power" || result == "sum");
+
+            // chain: P = P x A step by step
+            // squaring: binary powering, sum is doubled as S = S + P x S
+            // frontier: only new pairs are expanded F = (F x A) \ S, sum only
+            mode = argsProcessor.getOption("mode", "chain");
+            assert(mode == "chain" || mode == "squaring" || mode == "frontier");
+            assert(mode != "frontier" || result == "sum");
+
+            power = std::stoull(argsProcessor.getOption("power", "3"));
+            assert(power >= 1);
+
+            // Stop (not completed) if intermediate result grows beyond the budget, 0 is unlimited
+            maxNvals = std::stoull(argsProcessor.getOption("max-nvals", "0"));
+
+            benchmarkName = "SuiteSparse-PowerChain-" + result + "-" + mode;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~PowerChain() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        struct Step {
+            std::string op;
+            size_t power;
+            size_t nvals;
+            size_t sumNvals;
+            double mxmMs;
+            double addMs;
+        };
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            A = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            steps.clear();
+            completed = true;
+            powerNvals = input.nvals;
+            sumNvals = 0;
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            bool sum = result == "sum";
+
+            // P = A^m, S = A + ... + A^m, intermediate results stay inside of the library
+            GrB_CHECK(GrB_Matrix_dup(&P, A));
+            if (sum) {
+                GrB_CHECK(GrB_Matrix_dup(&S, A));
+                sumNvals = input.nvals;
+            }
+
+            if (mode == "chain") {
+                for (size_t m = 2; m <= power && !stop(); m++) {
+                    Step step{"chain", m};
+                    step.mxmMs = mxm(P, nullptr, nullptr, P, A);
+                    if (sum)
+                        step.addMs = add(S, P);
+                    pushStep(step);
+                }
+            }
+            else if (mode == "frontier") {
+                // P is a frontier: pairs, which are reachable in exactly m hops and not less
+                for (size_t m = 2; m <= power && !stop() && powerNvals > 0; m++) {
+                    Step step{"frontier", m};
+                    step.mxmMs = mxm(P, S, GrB_DESC_RSC, P, A);
+                    step.addMs = add(S, P);
+                    pushStep(step);
+                }
+            }
+            else {
+                size_t bit = highestBit(power);
+                size_t m = 1;
+
+                while (bit > 1 && !stop()) {
+                    bit >>= 1;
+                    bool increment = (power & bit) != 0;
+                    bool last = bit == 1 && !increment;
+
+                    // Double: S = S + P x S, P = P x P, last power is not needed for the sum
+                    Step doubling{"square", 2 * m};
+                    if (sum) {
+                        GrB_Matrix Q = nullptr;
+                        GrB_CHECK(GrB_Matrix_new(&Q, GrB_BOOL, input.nrows, input.ncols));
+                        doubling.mxmMs = mxm(Q, nullptr, nullptr, P, S);
+                        doubling.addMs = add(S, Q);
+                        GrB_CHECK(GrB_Matrix_free(&Q));
+                    }
+                    if (!sum || !last)
+                        doubling.mxmMs += mxm(P, nullptr, nullptr, P, P);
+                    m *= 2;
+                    pushStep(doubling);
+
+                    // Increment: P = P x A, S = S + P
+                    if (increment && !stop()) {
+                        Step step{"chain", m + 1};
+                        step.mxmMs = mxm(P, nullptr, nullptr, P, A);
+                        if (sum)
+                            step.addMs = add(S, P);
+                        m += 1;
+                        pushStep(step);
+                    }
+                }
+            }
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            Step total{};
+
+            for (size_t i = 0; i < steps.size(); i++) {
+                auto& step = steps[i];
+                total.mxmMs += step.mxmMs;
+                total.addMs += step.addMs;
+
+#ifdef BENCH_DEBUG
+                log << "   step " << i << " (" << step.op << "): power " << step.power << " nvals " << step.nvals;
+                if (result == "sum")
+                    log << " sum nvals " << step.sumNvals;
+                log << " mxm " << step.mxmMs << " ms add " << step.addMs << " ms" << std::endl;
+#endif
+            }
+
+            size_t nvals = result == "sum" ? sumNvals : powerNvals;
+            double n = (double) input.nrows;
+
+            addStageSample("mxm", total.mxmMs);
+            addStageSample("add", total.addMs);
+
+            addMetric("steps", (double) steps.size());
+            addMetric("nvals", (double) nvals);
+            addMetric("growth", input.nvals > 0 ? (double) nvals / (double) input.nvals : 0.0);
+            addMetric("density", n > 0 ? (double) nvals / (n * n) : 0.0);
+            addMetric("completed", completed ? 1.0 : 0.0);
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << input.ncols
+                << " nvals " << nvals << " steps " << steps.size() << " completed " << completed << std::endl;
+#endif
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            if (completed)
+                references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":" + result + "-" + std::to_string(power), std::to_string(nvals));
+
+
+            GrB_CHECK(GrB_Matrix_free(&P));
+            P = nullptr;
+
+            if (S != nullptr)
+                GrB_CHECK(GrB_Matrix_free(&S));
+            S = nullptr;
+        }
+
+        double mxm(GrB_Matrix C, GrB_Matrix M, GrB_Descriptor desc, GrB_Matrix X, GrB_Matrix Y) {
+            Timer timer;
+            timer.start();
+            GrB_CHECK(GrB_mxm(C, M, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, X, Y, desc));
+            timer.end();
+            return timer.getElapsedTimeMs();
+        }
+
+        double add(GrB_Matrix C, GrB_Matrix X) {
+            Timer timer;
+            timer.start();
+            GrB_CHECK(GrB_Matrix_eWiseAdd_BinaryOp(C, nullptr, nullptr, GrB_LOR, C, X, nullptr));
+            timer.end();
+            return timer.getElapsedTimeMs();
+        }
+
+        void pushStep(Step& step) {
+            GrB_CHECK(GrB_Matrix_nvals(&powerNvals, P));
+            if (S != nullptr) {
+                GrB_CHECK(GrB_Matrix_nvals(&sumNvals, S));
+            }
+
+            step.nvals = powerNvals;
+            step.sumNvals = sumNvals;
+            steps.push_back(step);
+        }
+
+        static size_t highestBit(size_t x) {
+            size_t bit = 1;
+            while (bit <= x / 2)
+                bit <<= 1;
+            return bit;
+        }
+
+        bool stop() {
+            completed = completed && !(maxNvals > 0 && std::max(powerNvals, sumNvals) > maxNvals);
+            return !completed;
+        }
+
+    protected:
+
+        GrB_Matrix A = nullptr;
+        GrB_Matrix P = nullptr;
+        GrB_Matrix S = nullptr;
+
+        std::string result;
+        std::string mode;
+        size_t power;
+        size_t maxNvals;
+
+        std::vector<Step> steps;
+        GrB_Index powerNvals = 0;
+        GrB_Index sumNvals = 0;
+        bool completed = true;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::PowerChain powerChain(argc, argv);
+    powerChain.runBenchmark();
+    return 0;
+}
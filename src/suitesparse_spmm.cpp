@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////////
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2021 Egor Orachyov                                               //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark_base.hpp>
+#include <matrix_loader.hpp>
+#include <matrix_utils.hpp>
+#include <args_processor.hpp>
+#include <profile_mem.hpp>
+#include <reference_values.hpp>
+
+extern "C"
+{
+#include <GraphBLAS.h>
+};
+
+#define BENCH_DEBUG
+#define GrB_CHECK(func) do { auto s = func; assert(s == GrB_SUCCESS); } while(0);
+
+namespace benchmark {
+    class MultiplyDense : public BenchmarkBase {
+    public:
+
+        MultiplyDense(int argc, const char** argv) {
+            argsProcessor.parse(argc, argv);
+            assert(argsProcessor.isParsed());
+
+            // Dense operand X is n x columns with random entries set with given probability
+            columns = std::stoull(argsProcessor.getOption("columns", "64"));
+            density = std::stod(argsProcessor.getOption("density", "0.05"));
+            assert(columns > 0);
+
+            // bitmap: only set entries of dense operand are present, full: all entries are present with false values
+            format = argsProcessor.getOption("format", "bitmap");
+            assert(format == "bitmap" || format == "full");
+
+            benchmarkName = "SuiteSparse-SpMM-" + std::to_string(columns) + "-" + format;
+            experimentsCount = argsProcessor.getExperimentsCount();
+        }
+
+        ~MultiplyDense() {
+            output_mem_profile(benchmarkName + "-Mem.txt", argsProcessor.getInputString());
+        }
+
+    protected:
+
+        void setupBenchmark() override {
+            GrB_CHECK(GrB_init(GrB_BLOCKING));
+        }
+
+        void tearDownBenchmark() override {
+            GrB_CHECK(GrB_finalize());
+        }
+
+        void setupExperiment(size_t experimentIdx, size_t& iterationsCount, std::string& name) override {
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+
+            iterationsCount = entry.iterations;
+            name = entry.name;
+
+            const auto& file = entry.name;
+            const auto& type = entry.isUndirected;
+
+            MatrixLoader loader(file, type);
+            loader.loadData();
+            input = std::move(loader.getMatrix());
+
+#ifdef BENCH_DEBUG
+            log << ">   Load matrix: \"" << file << "\" isUndirected: " << type << std::endl
+                << "                 size: " << input.nrows << " x " << input.ncols << " nvals: " << input.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            size_t n = input.nrows;
+            assert(input.nrows == input.ncols);
+
+            GrB_CHECK(GrB_Matrix_new(&A, GrB_BOOL, n, n));
+
+            std::vector<GrB_Index> I(input.nvals);
+            std::vector<GrB_Index> J(input.nvals);
+
+            bool* X = (bool*)std::malloc(sizeof(bool) * input.nvals);
+
+            for (auto i = 0; i < input.nvals; i++) {
+                I[i] = input.rows[i];
+                J[i] = input.cols[i];
+                X[i] = true;
+            }
+
+            GrB_CHECK(GrB_Matrix_build_BOOL(A, I.data(), J.data(), X, input.nvals, GrB_FIRST_BOOL));
+
+            std::free(X);
+
+            // The same dense operand for all backends
+            dense = randomMatrix(input.ncols, columns, density, DENSE_SEED);
+
+#ifdef BENCH_DEBUG
+            log << ">   Dense operand: size " << dense.nrows << " x " << dense.ncols << " nvals: " << dense.nvals << std::endl;
+#endif // BENCH_DEBUG
+
+            GrB_CHECK(GrB_Matrix_new(&B, GrB_BOOL, dense.nrows, dense.ncols));
+
+            if (format == "full") {
+                GrB_Index total = dense.nrows * dense.ncols;
+                std::vector<GrB_Index> BI(total);
+                std::vector<GrB_Index> BJ(total);
+                bool* BX = (bool*)std::malloc(sizeof(bool) * total);
+
+                for (GrB_Index k = 0; k < total; k++) {
+                    BI[k] = k / dense.ncols;
+                    BJ[k] = k % dense.ncols;
+                    BX[k] = false;
+                }
+
+                for (size_t k = 0; k < dense.nvals; k++)
+                    BX[dense.rows[k] * dense.ncols + dense.cols[k]] = true;
+
+                GrB_CHECK(GrB_Matrix_build_BOOL(B, BI.data(), BJ.data(), BX, total, GrB_FIRST_BOOL));
+                GrB_CHECK(GxB_Matrix_Option_set(B, GxB_SPARSITY_CONTROL, GxB_FULL));
+
+                std::free(BX);
+            }
+            else {
+                std::vector<GrB_Index> BI(dense.rows.begin(), dense.rows.end());
+                std::vector<GrB_Index> BJ(dense.cols.begin(), dense.cols.end());
+                bool* BX = (bool*)std::malloc(sizeof(bool) * dense.nvals);
+
+                for (size_t k = 0; k < dense.nvals; k++)
+                    BX[k] = true;
+
+                GrB_CHECK(GrB_Matrix_build_BOOL(B, BI.data(), BJ.data(), BX, dense.nvals, GrB_FIRST_BOOL));
+                GrB_CHECK(GxB_Matrix_Option_set(B, GxB_SPARSITY_CONTROL, GxB_BITMAP));
+
+                std::free(BX);
+            }
+        }
+
+        void tearDownExperiment(size_t experimentIdx) override {
+            input = Matrix{};
+            dense = Matrix{};
+
+            GrB_CHECK(GrB_Matrix_free(&A));
+            GrB_CHECK(GrB_Matrix_free(&B));
+            A = nullptr;
+            B = nullptr;
+        }
+
+        void setupIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_CHECK(GrB_Matrix_new(&Y, GrB_BOOL, input.nrows, columns));
+        }
+
+        void execIteration(size_t experimentIdx, size_t iterationIdx) override {
+            GrB_CHECK(GrB_mxm(Y, nullptr, nullptr, GrB_LOR_LAND_SEMIRING_BOOL, A, B, nullptr));
+        }
+
+        void tearDownIteration(size_t experimentIdx, size_t iterationIdx) override {
+            // Full operand produces explicit false values, so only true values are counted
+            uint64_t nvals = 0;
+            GrB_CHECK(GrB_Matrix_reduce_UINT64(&nvals, nullptr, GrB_PLUS_MONOID_UINT64, Y, nullptr));
+
+#ifdef BENCH_DEBUG
+            log << "   Result matrix: size " << input.nrows << " x " << columns << " nvals " << nvals << std::endl;
+#endif
+
+            addMetric("nvals", (double) nvals);
+            addMetric("density", (double) nvals / ((double) input.nrows * (double) columns));
+
+            auto& entry = argsProcessor.getEntries()[experimentIdx];
+            references.check(ReferenceValues::datasetKey(entry.name, entry.isUndirected) + ":spmm-" + std::to_string(columns) + "-" + ReferenceValues::numberKey(density),
+                             std::to_string(nvals));
+
+            GrB_CHECK(GrB_Matrix_free(&Y));
+            Y = nullptr;
+        }
+
+    protected:
+
+        static const size_t DENSE_SEED = 1;
+
+        GrB_Matrix A = nullptr;
+        GrB_Matrix B = nullptr;
+        GrB_Matrix Y = nullptr;
+
+        size_t columns;
+        double density;
+        std::string format;
+        ReferenceValues references{"Reference-Values.txt"};
+
+        ArgsProcessor argsProcessor;
+        Matrix input;
+        Matrix dense;
+    };
+
+}
+
+int main(int argc, const char** argv) {
+    benchmark::MultiplyDense multiply(argc, argv);
+    multiply.runBenchmark();
+    return 0;
+}
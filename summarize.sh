@@ -11,4 +11,32 @@ for file in Summary-*; do
     echo "--" >> $filename
     cat $file >> $filename
   fi
+done
+
+# Kernels (stages) breakdown, reported by some benchmarks
+stagesFilename="Stages.txt"
+
+if [[ -f $stagesFilename ]]; then
+  rm $stagesFilename
+fi
+
+for file in Stages-*; do
+  if [[ -f $file ]]; then
+    echo "-- $file" >> $stagesFilename
+    cat $file >> $stagesFilename
+  fi
+done
+
+# Metrics (throughput and etc.), reported by some benchmarks
+metricsFilename="Metrics.txt"
+
+if [[ -f $metricsFilename ]]; then
+  rm $metricsFilename
+fi
+
+for file in Metrics-*; do
+  if [[ -f $file ]]; then
+    echo "-- $file" >> $metricsFilename
+    cat $file >> $metricsFilename
+  fi
 done
\ No newline at end of file
@@ -4,4 +4,18 @@ for i in Summary-*; do
     echo "Remove file: $i"
     rm $i
   fi
+done
+
+for i in Stages-*; do
+  if [[ -f $i ]]; then
+    echo "Remove file: $i"
+    rm $i
+  fi
+done
+
+for i in Metrics-*; do
+  if [[ -f $i ]]; then
+    echo "Remove file: $i"
+    rm $i
+  fi
 done
\ No newline at end of file
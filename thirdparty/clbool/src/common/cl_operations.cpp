@@ -45,7 +45,8 @@ void prefix_sum(Controls &controls,
         cl::EnqueueArgs eargs(controls.queue, cl::NDRange(global_work_size), cl::NDRange(work_group_size));
 
         uint32_t leaf_size = 1;
-        scan(eargs, a_gpu, array, local_array, total_sum_gpu, array_size);
+        cl::Event scan_event = scan(eargs, a_gpu, array, local_array, total_sum_gpu, array_size);
+        if (controls.profiling) controls.profiler.add("scan_blelloch", kernel_profiler::no_bin, scan_event);
 
         uint32_t outer = (array_size + block_size - 1) / block_size;
 
@@ -61,8 +62,12 @@ void prefix_sum(Controls &controls,
                                                cl::NDRange((outer + work_group_size - 1) / work_group_size *
                                                            work_group_size),
                                                cl::NDRange(work_group_size));
-            scan(eargs_in_recursion, *b_gpu_ptr, *a_gpu_ptr, local_array, total_sum_gpu, outer);
-            update(eargs, array, *a_gpu_ptr, array_size, leaf_size);
+            scan_event = scan(eargs_in_recursion, *b_gpu_ptr, *a_gpu_ptr, local_array, total_sum_gpu, outer);
+            cl::Event update_event = update(eargs, array, *a_gpu_ptr, array_size, leaf_size);
+            if (controls.profiling) {
+                controls.profiler.add("scan_blelloch", kernel_profiler::no_bin, scan_event);
+                controls.profiler.add("update_pref_sum", kernel_profiler::no_bin, update_event);
+            }
             outer = (outer + block_size - 1) / block_size;
             std::swap(a_gpu_ptr, b_gpu_ptr);
             std::swap(a_size_ptr, b_size_ptr);
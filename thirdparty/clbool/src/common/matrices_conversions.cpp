@@ -107,4 +107,72 @@ matrix_coo_cpu matrix_coo_from_gpu(Controls &controls, matrix_coo &m) {
                                      sizeof(matrix_dcsr::index_type) * cols_indices.size(), cols_indices.data());
 
     return matrix_coo_cpu(rows_indices, cols_indices);
-}
\ No newline at end of file
+}
+
+namespace {
+    template <typename Fill>
+    cl::Buffer create_mapped_buffer(Controls &controls, uint32_t size, Fill &&fill) {
+        if (size == 0) return cl::Buffer();
+
+        cl::Buffer buffer(controls.context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, sizeof(uint32_t) * size);
+
+        // CL_MAP_WRITE_INVALIDATE_REGION is 1.2 only, we target 1.1
+        auto *ptr = static_cast<uint32_t *>(controls.queue.enqueueMapBuffer(buffer, CL_TRUE, CL_MAP_WRITE,
+                                                                            0, sizeof(uint32_t) * size));
+        fill(ptr);
+
+        // buffer may be used by async_queue next, so wait for unmap here
+        cl::Event unmap_event;
+        controls.queue.enqueueUnmapMemObject(buffer, ptr, nullptr, &unmap_event);
+        unmap_event.wait();
+
+        return buffer;
+    }
+}
+
+matrix_dcsr matrix_dcsr_from_sorted_coo_mapped(Controls &controls, const cpu_buffer &rows, const cpu_buffer &cols,
+                                               uint32_t n_rows, uint32_t n_cols) {
+    uint32_t nnz = rows.size();
+    uint32_t nzr = 0;
+
+    for (uint32_t i = 0; i < nnz; ++i) {
+        if (i == 0 || rows[i] != rows[i - 1]) ++nzr;
+    }
+
+    cl::Buffer rows_pointers = create_mapped_buffer(controls, nzr + 1, [&](uint32_t *ptr) {
+        uint32_t row = 0;
+        for (uint32_t i = 0; i < nnz; ++i) {
+            if (i == 0 || rows[i] != rows[i - 1]) ptr[row++] = i;
+        }
+        ptr[nzr] = nnz;
+    });
+
+    cl::Buffer rows_compressed = create_mapped_buffer(controls, nzr, [&](uint32_t *ptr) {
+        uint32_t row = 0;
+        for (uint32_t i = 0; i < nnz; ++i) {
+            if (i == 0 || rows[i] != rows[i - 1]) ptr[row++] = rows[i];
+        }
+    });
+
+    cl::Buffer cols_indices = create_mapped_buffer(controls, nnz, [&](uint32_t *ptr) {
+        std::copy(cols.begin(), cols.end(), ptr);
+    });
+
+    return matrix_dcsr(rows_pointers, rows_compressed, cols_indices,
+                       n_rows, n_cols, nnz, nzr);
+}
+
+matrix_coo matrix_coo_from_sorted_coo_mapped(Controls &controls, const cpu_buffer &rows, const cpu_buffer &cols,
+                                             uint32_t n_rows, uint32_t n_cols) {
+    uint32_t nnz = rows.size();
+
+    cl::Buffer rows_indices = create_mapped_buffer(controls, nnz, [&](uint32_t *ptr) {
+        std::copy(rows.begin(), rows.end(), ptr);
+    });
+
+    cl::Buffer cols_indices = create_mapped_buffer(controls, nnz, [&](uint32_t *ptr) {
+        std::copy(cols.begin(), cols.end(), ptr);
+    });
+
+    return matrix_coo(n_rows, n_cols, nnz, rows_indices, cols_indices);
+}
@@ -12,4 +12,12 @@ matrix_coo dcsr_to_coo(Controls &controls, matrix_dcsr &a);
 matrix_dcsr coo_to_dcsr_gpu(Controls &controls, const matrix_coo &a);
 matrix_dcsr matrix_dcsr_from_cpu(Controls &controls, matrix_dcsr_cpu &m, uint32_t size);
 matrix_dcsr_cpu matrix_dcsr_from_gpu(Controls &controls, matrix_dcsr &m);
-matrix_coo_cpu matrix_coo_from_gpu(Controls &controls, matrix_coo &m);
\ No newline at end of file
+matrix_coo_cpu matrix_coo_from_gpu(Controls &controls, matrix_coo &m);
+
+// build matrix right in CL_MEM_ALLOC_HOST_PTR buffers, filled through enqueueMapBuffer,
+// so no intermediate cpu copies are made (and no host-device copy at all on CPU devices and iGPUs)
+// rows and cols are coo indices sorted by (row, col)
+matrix_dcsr matrix_dcsr_from_sorted_coo_mapped(Controls &controls, const cpu_buffer &rows, const cpu_buffer &cols,
+                                               uint32_t n_rows, uint32_t n_cols);
+matrix_coo matrix_coo_from_sorted_coo_mapped(Controls &controls, const cpu_buffer &rows, const cpu_buffer &cols,
+                                             uint32_t n_rows, uint32_t n_cols);
\ No newline at end of file
@@ -56,7 +56,7 @@ namespace utils {
         return (n + work_group_size - 1) / work_group_size * work_group_size;
     }
 
-    Controls create_controls() {
+    Controls create_controls(bool profiling) {
         std::vector<cl::Platform> platforms;
         std::vector<cl::Device> devices;
         std::vector<cl::Kernel> kernels;
@@ -66,7 +66,7 @@ namespace utils {
             cl::Platform::get(&platforms);
             platforms[0].getDevices(CL_DEVICE_TYPE_GPU, &devices);
             std::cout << devices[0].getInfo<CL_DEVICE_MAX_WORK_GROUP_SIZE>() << std::endl;
-            return Controls(devices[0]);
+            return Controls(devices[0], profiling);
 
         } catch (const cl::Error &e) {
             std::stringstream exception;
@@ -20,7 +20,7 @@ namespace utils {
 
     uint32_t calculate_global_size(uint32_t work_group_size, uint32_t n);
 
-    Controls create_controls();
+    Controls create_controls(bool profiling = false);
 
     std::string error_name(cl_int error);
 
@@ -259,6 +259,12 @@ namespace coo_utils {
         uint32_t matrix_b_nRows = std::max_element(matrix_b.begin(), matrix_b.end(), less_for_rows)->first;
         uint32_t matrix_b_nCols = std::max_element(matrix_b.begin(), matrix_b.end(), less_for_cols)->second;
 
+        kronecker_product_cpu(matrix_out, matrix_a, matrix_b, matrix_b_nRows, matrix_b_nCols);
+    }
+
+    void
+    kronecker_product_cpu(matrix_coo_cpu_pairs &matrix_out, const matrix_coo_cpu_pairs &matrix_a, const matrix_coo_cpu_pairs &matrix_b,
+                          uint32_t matrix_b_nRows, uint32_t matrix_b_nCols) {
         matrix_out.resize(matrix_a.size() * matrix_b.size());
 
         uint32_t i = 0;
@@ -29,6 +29,10 @@ namespace coo_utils {
     void
     kronecker_product_cpu(matrix_coo_cpu_pairs &matrix_out, const matrix_coo_cpu_pairs &matrix_a, const matrix_coo_cpu_pairs &matrix_b);
 
+    void
+    kronecker_product_cpu(matrix_coo_cpu_pairs &matrix_out, const matrix_coo_cpu_pairs &matrix_a, const matrix_coo_cpu_pairs &matrix_b,
+                          uint32_t matrix_b_nRows, uint32_t matrix_b_nCols);
+
     void print_matrix(const matrix_coo_cpu_pairs &m_cpu);
 
     void get_rows_pointers_and_compressed(cpu_buffer &rows_pointers,
@@ -57,4 +61,58 @@ namespace coo_utils {
 
     void print_matrix(const matrix_dcsr_cpu &m_cpu, uint32_t index = -1);
     void print_matrix(Controls &controls, const matrix_dcsr& m_gpu, uint32_t index = -1);
+
+
+    // multi-threaded (OpenMP) versions of cpu references, see coo_utils_parallel.cpp
+
+    void matrix_multiplication_cpu_parallel(matrix_dcsr_cpu &c,
+                                            const matrix_dcsr_cpu &a,
+                                            const matrix_dcsr_cpu &b);
+
+    matrix_dcsr_cpu coo_to_dcsr_cpu_parallel(const matrix_coo_cpu_pairs &matrix_coo);
+
+    void matrix_addition_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                      const matrix_coo_cpu_pairs &matrix_a,
+                                      const matrix_coo_cpu_pairs &matrix_b);
+
+    // result is written in sorted order, b_n_rows and b_n_cols must be greater than any b index
+    void kronecker_product_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                        const matrix_coo_cpu_pairs &matrix_a,
+                                        const matrix_coo_cpu_pairs &matrix_b,
+                                        uint32_t b_n_rows,
+                                        uint32_t b_n_cols);
+
+    // b size is taken as max index + 1
+    void kronecker_product_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                        const matrix_coo_cpu_pairs &matrix_a,
+                                        const matrix_coo_cpu_pairs &matrix_b);
+
+
+    // cpu references as selectable backend, so they could be benchmarked against each other
+
+    enum class cpu_backend {
+        sequential,
+        parallel
+    };
+
+    cpu_backend cpu_backend_from_name(const std::string &name);
+
+    void matrix_multiplication_cpu(cpu_backend backend,
+                                   matrix_dcsr_cpu &c,
+                                   const matrix_dcsr_cpu &a,
+                                   const matrix_dcsr_cpu &b);
+
+    matrix_dcsr_cpu coo_to_dcsr_cpu(cpu_backend backend, const matrix_coo_cpu_pairs &matrix_coo);
+
+    void matrix_addition_cpu(cpu_backend backend,
+                             matrix_coo_cpu_pairs &matrix_out,
+                             const matrix_coo_cpu_pairs &matrix_a,
+                             const matrix_coo_cpu_pairs &matrix_b);
+
+    void kronecker_product_cpu(cpu_backend backend,
+                               matrix_coo_cpu_pairs &matrix_out,
+                               const matrix_coo_cpu_pairs &matrix_a,
+                               const matrix_coo_cpu_pairs &matrix_b,
+                               uint32_t b_n_rows,
+                               uint32_t b_n_cols);
 }
@@ -0,0 +1,309 @@
+#include <cstdint>
+#include "coo_utils.hpp"
+#include <vector>
+#include <algorithm>
+#include <omp.h>
+
+namespace coo_utils {
+
+    namespace {
+        const uint32_t no_position = uint32_t(-1);
+
+        // position of the row in compressed rows or no_position, if row is empty
+        uint32_t find_row(const cpu_buffer &rows_compressed, uint32_t row) {
+            auto it = std::lower_bound(rows_compressed.begin(), rows_compressed.end(), row);
+            if (it == rows_compressed.end() || *it != row) return no_position;
+            return it - rows_compressed.begin();
+        }
+
+        // first positions of rows groups in sorted coordinates, last item is the size of matrix
+        cpu_buffer rows_starts(const matrix_coo_cpu_pairs &m) {
+            cpu_buffer starts;
+            for (uint32_t i = 0; i < m.size(); ++i) {
+                if (i == 0 || m[i].first != m[i - 1].first) starts.push_back(i);
+            }
+            starts.push_back(m.size());
+            return starts;
+        }
+    }
+
+    /*
+     * Row-partitioned Gustavson: each thread owns a dense marker over b columns,
+     * first pass counts exact nnz of each row of c, second one writes and sorts the rows in place
+     */
+    void matrix_multiplication_cpu_parallel(matrix_dcsr_cpu &c,
+                                            const matrix_dcsr_cpu &a,
+                                            const matrix_dcsr_cpu &b) {
+        uint32_t a_nzr = a.rows_compressed().size();
+        const cpu_buffer &b_cols = b.cols_indices();
+
+        uint32_t b_n_cols = 0;
+#pragma omp parallel for reduction(max: b_n_cols)
+        for (size_t i = 0; i < b_cols.size(); ++i) {
+            b_n_cols = std::max(b_n_cols, b_cols[i] + 1);
+        }
+
+        cpu_buffer rows_nnz(a_nzr, 0);
+
+#pragma omp parallel
+        {
+            cpu_buffer marker(b_n_cols, no_position);
+
+#pragma omp for schedule(dynamic, 64)
+            for (uint32_t i = 0; i < a_nzr; ++i) {
+                uint32_t row_nnz = 0;
+                for (uint32_t j = a.rows_pointers()[i]; j < a.rows_pointers()[i + 1]; ++j) {
+                    uint32_t pos = find_row(b.rows_compressed(), a.cols_indices()[j]);
+                    if (pos == no_position) continue;
+                    for (uint32_t k = b.rows_pointers()[pos]; k < b.rows_pointers()[pos + 1]; ++k) {
+                        if (marker[b_cols[k]] != i) {
+                            marker[b_cols[k]] = i;
+                            row_nnz++;
+                        }
+                    }
+                }
+                rows_nnz[i] = row_nnz;
+            }
+        }
+
+        // row of a gives row of c only if it is not empty
+        cpu_buffer c_rows_pointers;
+        cpu_buffer c_rows_compressed;
+        cpu_buffer a_rows_offsets(a_nzr);
+        uint32_t c_nnz = 0;
+        for (uint32_t i = 0; i < a_nzr; ++i) {
+            a_rows_offsets[i] = c_nnz;
+            if (rows_nnz[i] == 0) continue;
+            c_rows_pointers.push_back(c_nnz);
+            c_rows_compressed.push_back(a.rows_compressed()[i]);
+            c_nnz += rows_nnz[i];
+        }
+        c_rows_pointers.push_back(c_nnz);
+
+        cpu_buffer c_cols_indices(c_nnz);
+
+#pragma omp parallel
+        {
+            cpu_buffer marker(b_n_cols, no_position);
+
+#pragma omp for schedule(dynamic, 64)
+            for (uint32_t i = 0; i < a_nzr; ++i) {
+                if (rows_nnz[i] == 0) continue;
+                uint32_t position = a_rows_offsets[i];
+                for (uint32_t j = a.rows_pointers()[i]; j < a.rows_pointers()[i + 1]; ++j) {
+                    uint32_t pos = find_row(b.rows_compressed(), a.cols_indices()[j]);
+                    if (pos == no_position) continue;
+                    for (uint32_t k = b.rows_pointers()[pos]; k < b.rows_pointers()[pos + 1]; ++k) {
+                        if (marker[b_cols[k]] != i) {
+                            marker[b_cols[k]] = i;
+                            c_cols_indices[position++] = b_cols[k];
+                        }
+                    }
+                }
+                std::sort(c_cols_indices.begin() + a_rows_offsets[i], c_cols_indices.begin() + position);
+            }
+        }
+
+        c = matrix_dcsr_cpu(std::move(c_rows_pointers), std::move(c_rows_compressed), std::move(c_cols_indices));
+    }
+
+    /*
+     * Each thread counts rows heads in its chunk of sorted coordinates,
+     * exclusive scan of these counts gives positions of the chunk rows in compressed rows
+     */
+    matrix_dcsr_cpu coo_to_dcsr_cpu_parallel(const matrix_coo_cpu_pairs &matrix_coo) {
+        size_t nnz = matrix_coo.size();
+        cpu_buffer cols_indices(nnz);
+        cpu_buffer chunks_offsets(omp_get_max_threads() + 1, 0);
+        cpu_buffer rows_pointers;
+        cpu_buffer rows_compressed;
+
+        auto is_head = [&matrix_coo](size_t i) {
+            return i == 0 || matrix_coo[i].first != matrix_coo[i - 1].first;
+        };
+
+#pragma omp parallel
+        {
+            size_t chunks = omp_get_num_threads();
+            size_t chunk = omp_get_thread_num();
+            size_t begin = nnz * chunk / chunks;
+            size_t end = nnz * (chunk + 1) / chunks;
+
+            uint32_t heads = 0;
+            for (size_t i = begin; i < end; ++i) {
+                cols_indices[i] = matrix_coo[i].second;
+                heads += is_head(i);
+            }
+            chunks_offsets[chunk + 1] = heads;
+
+#pragma omp barrier
+#pragma omp single
+            {
+                for (size_t i = 0; i < chunks; ++i) {
+                    chunks_offsets[i + 1] += chunks_offsets[i];
+                }
+                rows_pointers.resize(chunks_offsets[chunks] + 1);
+                rows_compressed.resize(chunks_offsets[chunks]);
+                rows_pointers.back() = nnz;
+            }
+
+            uint32_t position = chunks_offsets[chunk];
+            for (size_t i = begin; i < end; ++i) {
+                if (!is_head(i)) continue;
+                rows_compressed[position] = matrix_coo[i].first;
+                rows_pointers[position] = i;
+                position++;
+            }
+        }
+
+        return matrix_dcsr_cpu(std::move(rows_pointers), std::move(rows_compressed), std::move(cols_indices));
+    }
+
+    /*
+     * Splits merged sequence into equal parts (merge path), moves split points to rows boundaries,
+     * so parts never share duplicates, then merges parts independently
+     */
+    void matrix_addition_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                      const matrix_coo_cpu_pairs &matrix_a,
+                                      const matrix_coo_cpu_pairs &matrix_b) {
+        size_t a_size = matrix_a.size();
+        size_t b_size = matrix_b.size();
+        size_t parts = omp_get_max_threads();
+
+        // row of k-th item of merged sequence
+        auto merged_row = [&](size_t k) -> uint32_t {
+            size_t lo = k > b_size ? k - b_size : 0;
+            size_t hi = std::min(k, a_size);
+            while (lo < hi) {
+                size_t i = (lo + hi) / 2;
+                if (matrix_a[i] < matrix_b[k - i - 1]) lo = i + 1;
+                else hi = i;
+            }
+            size_t j = k - lo;
+            if (lo < a_size && (j >= b_size || matrix_a[lo] <= matrix_b[j])) return matrix_a[lo].first;
+            return matrix_b[j].first;
+        };
+
+        std::vector<size_t> a_splits(parts + 1, a_size);
+        std::vector<size_t> b_splits(parts + 1, b_size);
+        a_splits[0] = b_splits[0] = 0;
+        for (size_t p = 1; p < parts; ++p) {
+            size_t k = (a_size + b_size) * p / parts;
+            if (k >= a_size + b_size) continue;
+            coordinates row_begin(merged_row(k), 0);
+            a_splits[p] = std::lower_bound(matrix_a.begin(), matrix_a.end(), row_begin) - matrix_a.begin();
+            b_splits[p] = std::lower_bound(matrix_b.begin(), matrix_b.end(), row_begin) - matrix_b.begin();
+        }
+
+        std::vector<matrix_coo_cpu_pairs> merged(parts);
+        std::vector<size_t> offsets(parts + 1, 0);
+
+#pragma omp parallel for schedule(static, 1)
+        for (size_t p = 0; p < parts; ++p) {
+            auto &part = merged[p];
+            part.reserve((a_splits[p + 1] - a_splits[p]) + (b_splits[p + 1] - b_splits[p]));
+            std::merge(matrix_a.begin() + a_splits[p], matrix_a.begin() + a_splits[p + 1],
+                       matrix_b.begin() + b_splits[p], matrix_b.begin() + b_splits[p + 1],
+                       std::back_inserter(part));
+            part.erase(std::unique(part.begin(), part.end()), part.end());
+            offsets[p + 1] = part.size();
+        }
+
+        for (size_t p = 0; p < parts; ++p) {
+            offsets[p + 1] += offsets[p];
+        }
+
+        matrix_out.resize(offsets[parts]);
+
+#pragma omp parallel for schedule(static, 1)
+        for (size_t p = 0; p < parts; ++p) {
+            std::copy(merged[p].begin(), merged[p].end(), matrix_out.begin() + offsets[p]);
+        }
+    }
+
+    /*
+     * Rows of the result are ordered by (row of a, row of b), entries of a result row by (col of a, col of b),
+     * so each (row of a, row of b) block has known position in the sorted result and no sort is required
+     */
+    void kronecker_product_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                        const matrix_coo_cpu_pairs &matrix_a,
+                                        const matrix_coo_cpu_pairs &matrix_b,
+                                        uint32_t b_n_rows,
+                                        uint32_t b_n_cols) {
+        cpu_buffer a_starts = rows_starts(matrix_a);
+        cpu_buffer b_starts = rows_starts(matrix_b);
+        int64_t a_groups = a_starts.size() - 1;
+        int64_t b_groups = b_starts.size() - 1;
+        size_t b_size = matrix_b.size();
+
+        matrix_out.resize(matrix_a.size() * b_size);
+
+#pragma omp parallel for collapse(2) schedule(dynamic, 64)
+        for (int64_t ga = 0; ga < a_groups; ++ga) {
+            for (int64_t gb = 0; gb < b_groups; ++gb) {
+                size_t a_row_size = a_starts[ga + 1] - a_starts[ga];
+                size_t b_row_size = b_starts[gb + 1] - b_starts[gb];
+                size_t position = size_t(a_starts[ga]) * b_size + a_row_size * b_starts[gb];
+                uint32_t row = matrix_a[a_starts[ga]].first * b_n_rows + matrix_b[b_starts[gb]].first;
+
+                for (size_t ia = a_starts[ga]; ia < a_starts[ga + 1]; ++ia) {
+                    uint32_t col_base = matrix_a[ia].second * b_n_cols;
+                    for (size_t ib = b_starts[gb]; ib < b_starts[gb + 1]; ++ib) {
+                        matrix_out[position++] = coordinates(row, col_base + matrix_b[ib].second);
+                    }
+                }
+            }
+        }
+    }
+
+    void kronecker_product_cpu_parallel(matrix_coo_cpu_pairs &matrix_out,
+                                        const matrix_coo_cpu_pairs &matrix_a,
+                                        const matrix_coo_cpu_pairs &matrix_b) {
+        uint32_t b_n_rows = 0;
+        uint32_t b_n_cols = 0;
+        for (const auto &coord_b: matrix_b) {
+            b_n_rows = std::max(b_n_rows, coord_b.first + 1);
+            b_n_cols = std::max(b_n_cols, coord_b.second + 1);
+        }
+        kronecker_product_cpu_parallel(matrix_out, matrix_a, matrix_b, b_n_rows, b_n_cols);
+    }
+
+    // ------------------------------------- backend selection -------------------------------------
+
+    cpu_backend cpu_backend_from_name(const std::string &name) {
+        if (name == "sequential") return cpu_backend::sequential;
+        if (name == "parallel") return cpu_backend::parallel;
+        throw std::runtime_error("unknown cpu backend " + name + ", expected sequential or parallel");
+    }
+
+    void matrix_multiplication_cpu(cpu_backend backend,
+                                   matrix_dcsr_cpu &c,
+                                   const matrix_dcsr_cpu &a,
+                                   const matrix_dcsr_cpu &b) {
+        if (backend == cpu_backend::parallel) matrix_multiplication_cpu_parallel(c, a, b);
+        else matrix_multiplication_cpu(c, a, b);
+    }
+
+    matrix_dcsr_cpu coo_to_dcsr_cpu(cpu_backend backend, const matrix_coo_cpu_pairs &matrix_coo) {
+        if (backend == cpu_backend::parallel) return coo_to_dcsr_cpu_parallel(matrix_coo);
+        return coo_to_dcsr_cpu(matrix_coo);
+    }
+
+    void matrix_addition_cpu(cpu_backend backend,
+                             matrix_coo_cpu_pairs &matrix_out,
+                             const matrix_coo_cpu_pairs &matrix_a,
+                             const matrix_coo_cpu_pairs &matrix_b) {
+        if (backend == cpu_backend::parallel) matrix_addition_cpu_parallel(matrix_out, matrix_a, matrix_b);
+        else matrix_addition_cpu(matrix_out, matrix_a, matrix_b);
+    }
+
+    void kronecker_product_cpu(cpu_backend backend,
+                               matrix_coo_cpu_pairs &matrix_out,
+                               const matrix_coo_cpu_pairs &matrix_a,
+                               const matrix_coo_cpu_pairs &matrix_b,
+                               uint32_t b_n_rows,
+                               uint32_t b_n_cols) {
+        if (backend == cpu_backend::parallel) kronecker_product_cpu_parallel(matrix_out, matrix_a, matrix_b, b_n_rows, b_n_cols);
+        else kronecker_product_cpu(matrix_out, matrix_a, matrix_b, b_n_rows, b_n_cols);
+    }
+}
@@ -22,6 +22,7 @@ int main() {
 //    test_multiplication();
     test_multiplication_hash();
 //    testNewBitonicSort();
+//    testCpuReferencesParallel();
 }
 
 
@@ -106,6 +106,7 @@ void create_final_matrix(Controls &controls,
                 .set_block_size(std::min(controls.block_size, std::max(32u, utils::ceil_to_power2(groups_length[1]))))
                 .set_needed_work_size(groups_length[1])
                 .set_async(true)
+                .set_bin_id(1)
                 .set_kernel_name("to_result");
 
         e1 = single_value_rows.run(controls, gpu_workload_groups, groups_pointers[1], groups_length[1],
@@ -231,6 +232,7 @@ void run_kernels(Controls &controls,
         if (workload_group_id == 1) {
             //std::cout << "first group!\n";
             copy_one_value.set_needed_work_size(groups_length[workload_group_id])
+            .set_bin_id(workload_group_id)
             .set_block_size(std::min(controls.block_size,
                                      std::max(32u, utils::ceil_to_power2(groups_length[workload_group_id]))));
             events.push_back(
@@ -250,6 +252,7 @@ void run_kernels(Controls &controls,
         if (workload_group_id < 33 ) {
             //std::cout << "2 - 32!: " << workload_group_id << "\n";
             heap_merge.set_needed_work_size(groups_length[workload_group_id])
+                        .set_bin_id(workload_group_id)
                         .add_option("NNZ_ESTIMATION", workload_group_id);
             events.push_back(heap_merge.run(controls, gpu_workload_groups, groups_pointers[workload_group_id], groups_length[workload_group_id],
                                             pre.rows_pointers_gpu(), pre.cols_indices_gpu(),
@@ -266,6 +269,7 @@ void run_kernels(Controls &controls,
             uint32_t block_size = std::max(32u, esc_estimation(workload_group_id) / 2);
             esc_kernel.add_option("NNZ_ESTIMATION", esc_estimation(workload_group_id))
             .set_block_size(block_size)
+            .set_bin_id(workload_group_id)
             .set_needed_work_size(block_size * groups_length[workload_group_id]);
             events.push_back(esc_kernel.run(
                     controls,
@@ -281,7 +285,8 @@ void run_kernels(Controls &controls,
 
 
         //std::cout << "37!\n";
-        merge_large_rows.set_needed_work_size(groups_length[workload_group_id] * controls.block_size);
+        merge_large_rows.set_needed_work_size(groups_length[workload_group_id] * controls.block_size)
+                        .set_bin_id(workload_group_id);
         events.push_back(merge_large_rows.run(controls,
                                               gpu_workload_groups, groups_pointers[workload_group_id],
                                               aux_mem_pointers, aux_mem,
@@ -143,7 +143,8 @@ void count_nnz(Controls &controls,
         if (DEBUG_ENABLE) *logger << "\n[count_nnz] group " << bin_id << ", size " << groups_length[bin_id];
 
         if (bin_id == 0) {
-            hash_pwarp.set_needed_work_size(groups_length[bin_id] * PWARP);
+            hash_pwarp.set_needed_work_size(groups_length[bin_id] * PWARP)
+                      .set_bin_id(bin_id);
             events.push_back(
                     hash_pwarp.run(controls, gpu_workload_groups, groups_pointers[bin_id], groups_length[bin_id],
                                    nnz_estimation, a.rows_pointers_gpu(), a.cols_indices_gpu(),
@@ -155,6 +156,7 @@ void count_nnz(Controls &controls,
 
         if (bin_id != MAX_GROUP_ID) {
             hash_tb.set_block_size(block_size);
+            hash_tb.set_bin_id(bin_id);
             hash_tb.add_option("TABLE_SIZE", hash_details::get_table_size(bin_id));
             hash_tb.set_needed_work_size(block_size * groups_length[bin_id]);
             events.push_back(hash_tb.run(controls, gpu_workload_groups, groups_pointers[bin_id], groups_length[bin_id],
@@ -166,6 +168,7 @@ void count_nnz(Controls &controls,
         }
 
         hash_global.set_block_size(block_size);
+        hash_global.set_bin_id(bin_id);
         hash_global.set_needed_work_size(block_size * groups_length[bin_id]);
         events.push_back(hash_global.run(controls, gpu_workload_groups, groups_pointers[bin_id], groups_length[bin_id],
                                          nnz_estimation, a.rows_pointers_gpu(), a.cols_indices_gpu(),
@@ -227,7 +230,8 @@ void fill_nnz(Controls &controls,
         uint32_t block_size = hash_details::get_block_size(bin_id);
 //        std::cout << "\n[fill_nnz] group " << bin_id << ", size " << groups_length[bin_id] << std::endl;
         if (bin_id == 0) {
-            hash_pwarp.set_needed_work_size(groups_length[bin_id] * PWARP);
+            hash_pwarp.set_needed_work_size(groups_length[bin_id] * PWARP)
+                      .set_bin_id(bin_id);
             events.push_back(
                     hash_pwarp.run(controls, gpu_workload_groups, groups_pointers[bin_id], groups_length[bin_id],
                                    pre_matrix_rows_pointers, c_cols, a.rows_pointers_gpu(), a.cols_indices_gpu(),
@@ -239,6 +243,7 @@ void fill_nnz(Controls &controls,
 
         if (bin_id != MAX_GROUP_ID) {
             hash_tb.set_block_size(block_size);
+            hash_tb.set_bin_id(bin_id);
             hash_tb.add_option("TABLE_SIZE", hash_details::get_table_size(bin_id));
             hash_tb.set_needed_work_size(block_size * groups_length[bin_id]);
             events.push_back(hash_tb.run(controls, gpu_workload_groups, groups_pointers[bin_id],
@@ -250,6 +255,7 @@ void fill_nnz(Controls &controls,
         }
 
         hash_global.set_block_size(block_size);
+        hash_global.set_bin_id(bin_id);
         hash_global.set_needed_work_size(block_size * groups_length[bin_id]);
         events.push_back(hash_global.run(controls, gpu_workload_groups, groups_pointers[bin_id],
                                          pre_matrix_rows_pointers, c_cols,
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../common/cl_includes.hpp"
+#include "kernel_profiler.hpp"
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -12,12 +13,16 @@ struct Controls {
     cl::CommandQueue queue;
     cl::CommandQueue async_queue;
     const uint32_t block_size = uint32_t(256);
+    // queues are created with CL_QUEUE_PROFILING_ENABLE, program::run records its launches into profiler
+    const bool profiling;
+    kernel_profiler profiler;
 
-    Controls(cl::Device device) :
+    Controls(cl::Device device, bool profiling = false) :
             device(device)
     , context(cl::Context(device))
-    , queue(cl::CommandQueue(context))
-    , async_queue(cl::CommandQueue(context, CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE))
+    , queue(cl::CommandQueue(context, profiling ? CL_QUEUE_PROFILING_ENABLE : 0))
+    , async_queue(cl::CommandQueue(context, CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE | (profiling ? CL_QUEUE_PROFILING_ENABLE : 0)))
+    , profiling(profiling)
     {}
 
     cl::Program create_program_from_source(const char * kernel, uint32_t length) const {
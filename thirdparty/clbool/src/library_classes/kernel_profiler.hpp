@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../common/cl_includes.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/*
+ * Collects device time of kernels, launched within profiling queues.
+ * Each launch is tagged by kernel name and workload bin id (if the kernel processes some bin).
+ */
+class kernel_profiler {
+public:
+    static const uint32_t no_bin = uint32_t(-1);
+
+    struct record {
+        std::string kernel_name;
+        uint32_t bin_id;
+        double time_ms;
+
+        std::string tag() const {
+            return bin_id == no_bin ? kernel_name : kernel_name + "[bin " + std::to_string(bin_id) + "]";
+        }
+    };
+
+private:
+    struct launch {
+        std::string kernel_name;
+        uint32_t bin_id;
+        cl::Event event;
+    };
+
+    std::vector<launch> _launches;
+
+public:
+
+    void add(const std::string &kernel_name, uint32_t bin_id, const cl::Event &event) {
+        _launches.push_back({kernel_name, bin_id, event});
+    }
+
+    /* waits for all recorded launches, returns their device time and forgets them */
+    std::vector<record> collect() {
+        std::vector<record> records;
+        records.reserve(_launches.size());
+
+        for (auto &l: _launches) {
+            l.event.wait();
+            cl_ulong start = l.event.getProfilingInfo<CL_PROFILING_COMMAND_START>();
+            cl_ulong end = l.event.getProfilingInfo<CL_PROFILING_COMMAND_END>();
+            records.push_back({l.kernel_name, l.bin_id, (double) (end - start) / 1.0e6});
+        }
+
+        _launches.clear();
+        return records;
+    }
+
+    void clear() {
+        _launches.clear();
+    }
+};
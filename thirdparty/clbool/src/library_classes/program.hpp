@@ -13,6 +13,7 @@ private:
     std::string _kernel_name;
     uint32_t _block_size = 0;
     uint32_t _needed_work_size = 0;
+    uint32_t _bin_id = kernel_profiler::no_bin;
     cl::Program cl_program;
     bool _built = false;
     bool _async = false;
@@ -81,6 +82,12 @@ public:
         return *this;
     }
 
+    // used to tag launches in kernel profiler
+    program& set_bin_id(uint32_t bin_id) {
+        _bin_id = bin_id;
+        return *this;
+    }
+
     program& set_async(bool async) {
         _async = async;
         return *this;
@@ -107,7 +114,9 @@ public:
                                   cl::NDRange(utils::calculate_global_size(_block_size, _needed_work_size)),
                                   cl::NDRange(_block_size));
 
-            return functor(eargs, args...);
+            cl::Event event = functor(eargs, args...);
+            if (controls.profiling) controls.profiler.add(_kernel_name, _bin_id, event);
+            return event;
         } catch (const cl::Error &e) {
             utils::program_handler(e, cl_program, controls.device, _kernel_name);
         }
@@ -21,4 +21,5 @@ void test_new_merge_full();
 void test_multiplication();
 void test_pref_sum();
 void testNewBitonicSort();
-void test_multiplication_hash();
\ No newline at end of file
+void test_multiplication_hash();
+void testCpuReferencesParallel();
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "coo_tests.hpp"
+#include "../coo/coo_utils.hpp"
+
+using namespace coo_utils;
+
+namespace {
+    void compare_dcsr(const matrix_dcsr_cpu &expected, const matrix_dcsr_cpu &actual, const std::string &name) {
+        if (expected.rows_pointers() != actual.rows_pointers() ||
+            expected.rows_compressed() != actual.rows_compressed() ||
+            expected.cols_indices() != actual.cols_indices()) {
+            throw std::runtime_error("parallel " + name + " differs from sequential one");
+        }
+    }
+}
+
+void testCpuReferencesParallel() {
+    for (uint32_t max_size = 10; max_size < 20000; max_size *= 3) {
+        for (uint32_t k = 1; k < 20; k += 6) {
+            uint32_t nnz_max = std::max(10u, max_size * k);
+            matrix_coo_cpu_pairs a_coo = generate_random_matrix_coo_cpu(nnz_max, max_size);
+            matrix_coo_cpu_pairs b_coo = generate_random_matrix_coo_cpu(nnz_max / 2 + 1, max_size);
+
+            matrix_dcsr_cpu a = coo_to_dcsr_cpu(a_coo);
+            compare_dcsr(a, coo_to_dcsr_cpu_parallel(a_coo), "coo_to_dcsr_cpu");
+
+            matrix_dcsr_cpu c;
+            matrix_dcsr_cpu c_parallel;
+            matrix_multiplication_cpu(c, a, a);
+            matrix_multiplication_cpu_parallel(c_parallel, a, a);
+            compare_dcsr(c, c_parallel, "matrix_multiplication_cpu");
+
+            matrix_coo_cpu_pairs sum;
+            matrix_coo_cpu_pairs sum_parallel;
+            matrix_addition_cpu(sum, a_coo, b_coo);
+            matrix_addition_cpu_parallel(sum_parallel, a_coo, b_coo);
+            if (sum != sum_parallel) throw std::runtime_error("parallel matrix_addition_cpu differs from sequential one");
+
+            if (max_size > 100) continue;
+            matrix_coo_cpu_pairs kron;
+            matrix_coo_cpu_pairs kron_parallel;
+            kronecker_product_cpu(kron, a_coo, b_coo, max_size, max_size);
+            kronecker_product_cpu_parallel(kron_parallel, a_coo, b_coo, max_size, max_size);
+            if (kron != kron_parallel) throw std::runtime_error("parallel kronecker_product_cpu differs from sequential one");
+
+            std::cout << "max_size = " << max_size << ", k = " << k << " correct" << std::endl;
+        }
+    }
+}